@@ -38,17 +38,7 @@ void Board::generateBoard()
             const int file = m_rotated ? (7-col) : col;
             const ModernChess::Square square = ModernChess::BitBoardOperations::getSquare(rank, file);
 
-            ModernChess::Figure figureOnSquare = ModernChess::Figure::None;
-
-            // loop over all figures bitboards
-            for (ModernChess::Figure figure = ModernChess::WhitePawn; figure <= ModernChess::BlackKing; ++figure)
-            {
-                if (ModernChess::BitBoardOperations::isOccupied(m_gameState.board.bitboards[figure], square))
-                {
-                    figureOnSquare = figure;
-                    break;
-                }
-            }
+            const ModernChess::Figure figureOnSquare = m_gameState.board.mailbox[square];
 
             m_squares.append(new SquareModel(getSquare(row, col), m_figureToResource[figureOnSquare], m_boardParent.get()));
         }
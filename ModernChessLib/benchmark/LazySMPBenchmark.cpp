@@ -0,0 +1,64 @@
+#include "ModernChess/FenParsing.h"
+#include "ModernChess/LazySMP.h"
+#include "ModernChess/Timer.h"
+
+#include <cstdlib>
+#include <iostream>
+#include <string_view>
+#include <thread>
+
+using namespace ModernChess;
+
+namespace {
+    struct Position {
+        std::string_view fen;
+        uint8_t searchDepth;
+    };
+
+    constexpr Position StartPosition{"rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1", 11};
+    // "Kiwipete" with many captures, castling and en passant moves
+    constexpr Position Kiwipete{"r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1", 9};
+
+    void benchmarkSearch(const Position &position, size_t numberOfThreads)
+    {
+        const GameState gameState = FenParsing::FenParser(position.fen).parse();
+        // Every search starts with an empty transposition table
+        TranspositionTable transpositionTable;
+        LazySMP lazySMP(transpositionTable, numberOfThreads);
+        StopSignal stopSignal;
+
+        const Timer timer;
+        const EvaluationResult result = lazySMP.search(gameState, PositionHistory(), position.searchDepth, stopSignal);
+        const auto duration = timer.duration();
+
+        // Avoid division by zero
+        const uint64_t nodesPerSecond = result.numberOfNodes * 1000 / std::max<uint64_t>(duration.count(), 1);
+
+        std::cout << "  " << numberOfThreads << " threads: depth " << result.depth << " in "
+                  << duration.count() << " ms, " << nodesPerSecond << " nps, best move " << result.bestMove()
+                  << std::endl;
+    }
+
+    void benchmarkPosition(const Position &position)
+    {
+        const size_t maxNumberOfThreads = std::max(std::thread::hardware_concurrency(), 1u);
+
+        for (size_t numberOfThreads = 1; numberOfThreads < maxNumberOfThreads; numberOfThreads *= 2)
+        {
+            benchmarkSearch(position, numberOfThreads);
+        }
+
+        benchmarkSearch(position, maxNumberOfThreads);
+    }
+}
+
+int main()
+{
+    std::cout << "Start position" << std::endl;
+    benchmarkPosition(StartPosition);
+
+    std::cout << "Kiwipete" << std::endl;
+    benchmarkPosition(Kiwipete);
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,117 @@
+#include "ModernChess/Evaluation.h"
+#include "ModernChess/FenParsing.h"
+#include "ModernChess/MoveExecution.h"
+#include "ModernChess/MoveGenerationMode.h"
+#include "ModernChess/Perft.h"
+#include "ModernChess/Timer.h"
+
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <string_view>
+
+using namespace ModernChess;
+
+namespace {
+    struct Position {
+        std::string_view fen;
+        uint32_t perftDepth;
+        uint64_t perftNodes;
+        uint8_t searchDepth;
+    };
+
+    constexpr Position StartPosition{"rnbqkbnr/pppppppp/8/8/8/8/PPPPPPPP/RNBQKBNR w KQkq - 0 1", 5, 4865609, 8};
+    // "Kiwipete" with many captures, castling and en passant moves
+    constexpr Position Kiwipete{"r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1", 4, 4085603, 7};
+    // 15 queens have 229 moves, more than any reachable position. They must still fit into the move list.
+    constexpr Position ManyQueens{"kb1Q1Q1K/pp4Q1/4Q3/1Q5Q/4Q3/Q5Q1/2QQ4/Q4QQQ w - - 0 1", 3, 95354, 3};
+
+    std::string toString(MoveUndoMode moveUndoMode)
+    {
+        return (moveUndoMode == MoveUndoMode::CopyMake) ? "copy-make  " : "make-unmake";
+    }
+
+    std::string toString(MoveGenerationMode moveGenerationMode)
+    {
+        return (moveGenerationMode == MoveGenerationMode::Legal) ? "legal " : "pseudo";
+    }
+
+    uint64_t benchmarkPerft(const Position &position, MoveGenerationMode moveGenerationMode, MoveUndoMode moveUndoMode)
+    {
+        const GameState gameState = FenParsing::FenParser(position.fen).parse();
+        Perft perft(0, 1, moveGenerationMode, moveUndoMode);
+
+        const Timer timer;
+        const uint64_t numberOfNodes = perft.countNodes(gameState, position.perftDepth);
+
+        std::cout << "  perft  " << toString(moveGenerationMode) << " " << toString(moveUndoMode) << ": "
+                  << numberOfNodes << " nodes in " << timer.duration().count() << " ms" << std::endl;
+
+        return numberOfNodes;
+    }
+
+    EvaluationResult benchmarkSearch(const Position &position, MoveGenerationMode moveGenerationMode, MoveUndoMode moveUndoMode)
+    {
+        // Every search starts with an empty transposition table
+        TranspositionTable transpositionTable;
+        Evaluation evaluation(FenParsing::FenParser(position.fen).parse(), transpositionTable);
+        evaluation.setMoveGenerationMode(moveGenerationMode);
+        evaluation.setMoveUndoMode(moveUndoMode);
+
+        const Timer timer;
+        const EvaluationResult result = evaluation.getBestMove(position.searchDepth);
+
+        std::cout << "  search " << toString(moveGenerationMode) << " " << toString(moveUndoMode) << ": "
+                  << result.numberOfNodes << " nodes in " << timer.duration().count() << " ms" << std::endl;
+
+        return result;
+    }
+
+    bool comparePosition(const Position &position)
+    {
+        bool resultsAreEqual = true;
+
+        for (const MoveGenerationMode moveGenerationMode : {MoveGenerationMode::Legal, MoveGenerationMode::PseudoLegal})
+        {
+            for (const MoveUndoMode moveUndoMode : {MoveUndoMode::CopyMake, MoveUndoMode::MakeUnmake})
+            {
+                resultsAreEqual = benchmarkPerft(position, moveGenerationMode, moveUndoMode) == position.perftNodes and
+                                  resultsAreEqual;
+            }
+        }
+
+        for (const MoveGenerationMode moveGenerationMode : {MoveGenerationMode::Legal, MoveGenerationMode::PseudoLegal})
+        {
+            const EvaluationResult copyMakeResult = benchmarkSearch(position, moveGenerationMode, MoveUndoMode::CopyMake);
+            const EvaluationResult makeUnmakeResult = benchmarkSearch(position, moveGenerationMode, MoveUndoMode::MakeUnmake);
+
+            // Both approaches must search exactly the same tree
+            resultsAreEqual = copyMakeResult.numberOfNodes == makeUnmakeResult.numberOfNodes and
+                              copyMakeResult.score == makeUnmakeResult.score and resultsAreEqual;
+        }
+
+        return resultsAreEqual;
+    }
+}
+
+int main()
+{
+    bool resultsAreEqual = true;
+
+    std::cout << "Start position" << std::endl;
+    resultsAreEqual = comparePosition(StartPosition) and resultsAreEqual;
+
+    std::cout << "Kiwipete" << std::endl;
+    resultsAreEqual = comparePosition(Kiwipete) and resultsAreEqual;
+
+    std::cout << "Many queens" << std::endl;
+    resultsAreEqual = comparePosition(ManyQueens) and resultsAreEqual;
+
+    if (not resultsAreEqual)
+    {
+        std::cerr << "Copy-make and make-unmake yield different results or wrong perft results!" << std::endl;
+        return EXIT_FAILURE;
+    }
+
+    return EXIT_SUCCESS;
+}
@@ -0,0 +1,116 @@
+#include "ModernChess/BishopAttacks.h"
+#include "ModernChess/RookAttacks.h"
+#include "ModernChess/SliderIndexing.h"
+#include "ModernChess/Timer.h"
+
+#include <cstdlib>
+#include <iostream>
+#include <random>
+#include <string>
+#include <vector>
+
+using namespace ModernChess;
+
+namespace {
+    struct Lookup {
+        Square square;
+        BitBoardState occupiedSquares;
+    };
+
+    constexpr size_t NumberOfLookups = 1 << 20;
+    constexpr size_t NumberOfRepetitions = 20;
+
+    /**
+     * @brief Generates random squares of sliding figures on boards with the given number of occupied squares
+     */
+    std::vector<Lookup> generateLookups(uint32_t numberOfOccupiedSquares)
+    {
+        // Fixed seed, so every backend and every run sees the same occupancies
+        std::mt19937_64 randomGenerator(numberOfOccupiedSquares);
+        std::uniform_int_distribution<int> squareDistribution(Square::a1, Square::h8);
+
+        std::vector<Lookup> lookups(NumberOfLookups);
+
+        for (Lookup &lookup : lookups)
+        {
+            lookup.square = Square(squareDistribution(randomGenerator));
+            lookup.occupiedSquares = BitBoardOperations::occupySquare(BoardState::empty, lookup.square);
+
+            while (BitBoardOperations::countBits(lookup.occupiedSquares) < numberOfOccupiedSquares)
+            {
+                const Square square = Square(squareDistribution(randomGenerator));
+                lookup.occupiedSquares = BitBoardOperations::occupySquare(lookup.occupiedSquares, square);
+            }
+        }
+
+        return lookups;
+    }
+
+    template<typename SlidingFigureAttacks>
+    uint64_t runBenchmark(const std::string &name, const SlidingFigureAttacks &attacks, const std::vector<Lookup> &lookups)
+    {
+        uint64_t checksum = 0;
+        Timer<std::chrono::nanoseconds> timer;
+
+        for (size_t repetition = 0; repetition < NumberOfRepetitions; ++repetition)
+        {
+            for (const Lookup &lookup : lookups)
+            {
+                // Depend on the previous lookup like a move generator, which uses the attacks
+                checksum += attacks.getAttacks(lookup.square, lookup.occupiedSquares ^ (checksum & 1));
+            }
+        }
+
+        const double nanosecondsPerLookup = double(timer.duration().count()) / double(NumberOfLookups * NumberOfRepetitions);
+        std::cout << "  " << name << ": " << nanosecondsPerLookup << " ns/lookup" << std::endl;
+
+        return checksum;
+    }
+
+    template<typename SlidingFigureAttacks>
+    bool compareBackends(const std::string &figureName, const std::vector<Lookup> &lookups)
+    {
+        const SlidingFigureAttacks magicAttacks(SliderIndexing::Magic);
+        const SlidingFigureAttacks pextAttacks(SliderIndexing::Pext);
+
+        const uint64_t magicChecksum = runBenchmark(figureName + " magic", magicAttacks, lookups);
+
+        if (pextAttacks.getIndexing() != SliderIndexing::Pext)
+        {
+            return true;
+        }
+
+        const uint64_t pextChecksum = runBenchmark(figureName + " PEXT ", pextAttacks, lookups);
+
+        if (magicChecksum != pextChecksum)
+        {
+            std::cerr << "  " << figureName << " attacks of magic and PEXT backend differ!" << std::endl;
+            return false;
+        }
+
+        return true;
+    }
+}
+
+int main()
+{
+    if (not SliderIndexingFunctions::cpuSupportsPext())
+    {
+        std::cout << "PEXT is not available. Only the magic backend is measured." << std::endl;
+    }
+
+    bool attacksAreEqual = true;
+
+    // From the opening to the endgame
+    for (const uint32_t numberOfOccupiedSquares : {32u, 24u, 16u, 8u})
+    {
+        std::cout << numberOfOccupiedSquares << " occupied squares" << std::endl;
+
+        const std::vector<Lookup> lookups = generateLookups(numberOfOccupiedSquares);
+
+        attacksAreEqual = compareBackends<RookAttacks>("rook  ", lookups) and attacksAreEqual;
+        attacksAreEqual = compareBackends<BishopAttacks>("bishop", lookups) and attacksAreEqual;
+    }
+
+    return attacksAreEqual ? EXIT_SUCCESS : EXIT_FAILURE;
+}
@@ -90,11 +90,63 @@ namespace ModernChess {
             return false;
         }
 
+        /**
+         * @param board current board
+         * @param square attacked square
+         * @param occupancy occupancy used for the sliding pieces. This makes it possible to query attacks after a
+         *                  piece has (virtually) left its square.
+         * @return Set of all figures of the attacker, which are attacking the given square
+         */
+        template<Color attacker>
+        static inline BitBoardState attackersOfSquare(const Board &board, Square square, BitBoardState occupancy)
+        {
+            constexpr Color defender = (attacker == Color::White) ? Color::Black : Color::White;
+            constexpr Figure pawn = (attacker == Color::White) ? Figure::WhitePawn : Figure::BlackPawn;
+            constexpr Figure knight = (attacker == Color::White) ? Figure::WhiteKnight : Figure::BlackKnight;
+            constexpr Figure bishop = (attacker == Color::White) ? Figure::WhiteBishop : Figure::BlackBishop;
+            constexpr Figure rook = (attacker == Color::White) ? Figure::WhiteRook : Figure::BlackRook;
+            constexpr Figure queen = (attacker == Color::White) ? Figure::WhiteQueen : Figure::BlackQueen;
+            constexpr Figure king = (attacker == Color::White) ? Figure::WhiteKing : Figure::BlackKing;
+
+            const BitBoardState diagonalSliders = board.bitboards[bishop] | board.bitboards[queen];
+            const BitBoardState straightSliders = board.bitboards[rook] | board.bitboards[queen];
+
+            return (pawnAttackTable[defender][square] & board.bitboards[pawn]) |
+                   (knightAttackTable[square] & board.bitboards[knight]) |
+                   (kingAttackTable[square] & board.bitboards[king]) |
+                   (bishopAttacks.getAttacks(square, occupancy) & diagonalSliders) |
+                   (rookAttacks.getAttacks(square, occupancy) & straightSliders);
+        }
+
+        /**
+         * @param board current board
+         * @param square attacked square
+         * @param occupancy occupancy used for the sliding pieces. Figures, which are not part of the occupancy, are not
+         *                  returned as attackers. Removing a figure from the occupancy discovers the sliding pieces
+         *                  behind it (x-rays).
+         * @return Set of all figures of both colors, which are attacking the given square
+         */
+        static inline BitBoardState attackersTo(const Board &board, Square square, BitBoardState occupancy)
+        {
+            return (attackersOfSquare<Color::White>(board, square, occupancy) |
+                    attackersOfSquare<Color::Black>(board, square, occupancy)) & occupancy;
+        }
+
+        template<Color attacker>
+        static inline bool squareIsAttacked(const Board &board, Square square, BitBoardState occupancy)
+        {
+            return attackersOfSquare<attacker>(board, square, occupancy) != BoardState::empty;
+        }
+
         static const std::array<std::array<BitBoardState, 64>, 2> pawnAttackTable;
         static const std::array<BitBoardState, 64> knightAttackTable;
         static const std::array<BitBoardState, 64> kingAttackTable;
         static const BishopAttacks bishopAttacks;
         static const RookAttacks rookAttacks;
         static const QueenAttacks queenAttacks;
+        // squares between two squares [from][to]
+        static const std::array<std::array<BitBoardState, 64>, 64> squaresBetween;
+        // complete line through two squares [from][to]
+        static const std::array<std::array<BitBoardState, 64>, 64> lines;
     };
 }
\ No newline at end of file
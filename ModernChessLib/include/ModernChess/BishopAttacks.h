@@ -5,6 +5,7 @@
 #include "PawnPushes.h"
 #include "Square.h"
 #include "Figure.h"
+#include "SliderIndexing.h"
 
 #include <array>
 
@@ -134,7 +135,7 @@ namespace ModernChess {
                     6, 5, 5, 5, 5, 5, 5, 6
             };
 
-            // Generated by test/MagicNumberCandidateGeneration.cpp
+            // Generated by tools/MagicNumberGeneration.cpp
             constexpr std::array<uint64_t, 64> magicNumbers {
                     0x40040844404084ULL,
                     0x2004208a004208ULL,
@@ -201,29 +202,78 @@ namespace ModernChess {
                     0x8918844842082200ULL,
                     0x4010011029020020ULL
             };
+
+            // Start of every square in the shared attack table
+            constexpr std::array<uint32_t, 64> tableOffsets = SliderIndexingFunctions::getTableOffsets(relevantBits);
+
+            // Number of entries of the shared attack table
+            constexpr size_t tableSize = SliderIndexingFunctions::getTableSize(relevantBits);
         };
+
+        [[nodiscard]] constexpr std::array<BitBoardState, 64> generateBishopAttackMasks()
+        {
+            std::array<BitBoardState, 64> attackMasks{};
+
+            for (Square square = Square::a1; square <= Square::h8; ++square)
+            {
+                attackMasks[square] = maskBishopAttacks(square);
+            }
+
+            return attackMasks;
+        }
+
+        [[nodiscard]] constexpr SliderIndexingFunctions::AttackTables<BishopMetaData::tableSize> generateBishopAttackTables()
+        {
+            constexpr std::array<SliderIndexingFunctions::Direction, 4> directions{{{1, 1}, {1, -1}, {-1, 1}, {-1, -1}}};
+
+            return SliderIndexingFunctions::generateAttackTables<BishopMetaData::tableSize>(directions,
+                                                                                          generateBishopAttackMasks(),
+                                                                                          BishopMetaData::relevantBits,
+                                                                                          BishopMetaData::magicNumbers);
+        }
     }
 
     class BishopAttacks {
     public:
-        BishopAttacks();
+        /**
+         * @param requestedIndexing PEXT falls back to magic numbers, if the CPU doesn't support it
+         */
+        explicit BishopAttacks(SliderIndexing requestedIndexing = SliderIndexingFunctions::getDefaultIndexing());
 
         [[nodiscard]] inline BitBoardState getAttacks(Square square, BitBoardState occupiedSquares) const
         {
+#ifdef MODERN_CHESS_USE_PEXT
+            if (indexing == SliderIndexing::Pext)
+            {
+                return pextAttacks[BishopAttackHelperFunctions::BishopMetaData::tableOffsets[square] +
+                                   SliderIndexingFunctions::extractBits(occupiedSquares, attackMasks[square])];
+            }
+#endif
             occupiedSquares &= attackMasks[square];
             occupiedSquares *= BishopAttackHelperFunctions::BishopMetaData::magicNumbers[square];
             occupiedSquares >>= 64 - BishopAttackHelperFunctions::BishopMetaData::relevantBits[square];
 
-            return bishopAttacks[square][occupiedSquares];
+            return magicAttacks[BishopAttackHelperFunctions::BishopMetaData::tableOffsets[square] + occupiedSquares];
+        }
+
+        [[nodiscard]] SliderIndexing getIndexing() const
+        {
+            return indexing;
         }
 
     private:
-        // bishop attack masks
-        std::array<BitBoardState, 64> attackMasks{};
+        SliderIndexing indexing;
 
-        // bishop attacks table [square][occupancies]
-        std::array<std::array<BitBoardState, 512>, 64> bishopAttacks{};
-    };
+        // bishop attack masks
+        static constexpr std::array<BitBoardState, 64> attackMasks =
+                BishopAttackHelperFunctions::generateBishopAttackMasks();
 
+        // bishop attacks table with magic index [tableOffsets[square] + magic index]
+        static const std::array<BitBoardState, BishopAttackHelperFunctions::BishopMetaData::tableSize> magicAttacks;
 
+#ifdef MODERN_CHESS_USE_PEXT
+        // bishop attacks table with PEXT index [tableOffsets[square] + PEXT index]
+        static const std::array<BitBoardState, BishopAttackHelperFunctions::BishopMetaData::tableSize> pextAttacks;
+#endif
+    };
 }
\ No newline at end of file
@@ -36,8 +36,10 @@ namespace ModernChess {
         constexpr BitBoardState notHFile = ~hFile;
         constexpr BitBoardState notGHFile = ~(gFile | hFile);
         constexpr BitBoardState rank1 = 0x00000000000000FF;
+        constexpr BitBoardState rank2 = 0x000000000000FF00;
         constexpr BitBoardState rank4 = 0x00000000FF000000;
         constexpr BitBoardState rank5 = 0x000000FF00000000;
+        constexpr BitBoardState rank7 = 0x00FF000000000000;
         constexpr BitBoardState rank8 = 0xFF00000000000000;
         constexpr BitBoardState a1H8Diagonal = 0x8040201008040201;
         constexpr BitBoardState h1A8Antidiagonal = 0x0102040810204080;
@@ -3,6 +3,7 @@
 #include "BitBoardConstants.h"
 #include "CastlingRights.h"
 #include "Color.h"
+#include "Figure.h"
 
 #include <array>
 #include <ostream>
@@ -16,6 +17,13 @@ namespace ModernChess
         std::array<BitBoardState, 12> bitboards{};
         // Occupancies for white, black and both colors
         std::array<BitBoardState, 3> occupancies{};
+        // Figure on every square or Figure::None, which is kept in sync with the bitboards.
+        // See https://www.chessprogramming.org/Mailbox
+        std::array<Figure, 64> mailbox = [] {
+            std::array<Figure, 64> emptyMailbox{};
+            emptyMailbox.fill(Figure::None);
+            return emptyMailbox;
+        }();
 
         Square enPassantTarget = Square::undefined;
         Color sideToMove = Color::White;
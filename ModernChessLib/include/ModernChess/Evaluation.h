@@ -1,13 +1,21 @@
 #pragma once
 
 #include "GameState.h"
+#include "MoveExecution.h"
+#include "MoveGenerationMode.h"
+#include "MovePicker.h"
+#include "PositionHistory.h"
 #include "PrincipalVariationTable.h"
+#include "StopSignal.h"
+#include "TranspositionTable.h"
 
 #include <array>
 #include <algorithm>
 #include <iostream>
 #include <limits>
 #include <memory>
+#include <utility>
+#include <vector>
 
 namespace ModernChess
 {
@@ -16,7 +24,7 @@ namespace ModernChess
         EvaluationResult() = default;
 
         explicit EvaluationResult(int32_t score,
-                                  uint32_t numberOfNodes,
+                                  uint64_t numberOfNodes,
                                   int32_t depth,
                                   std::shared_ptr<PrincipalVariationTable> pvTable) :
                 score(score),
@@ -26,7 +34,7 @@ namespace ModernChess
 
         [[nodiscard]] Move bestMove() const { return *pvTable->begin(); }
         int32_t score{};
-        uint32_t numberOfNodes{};
+        uint64_t numberOfNodes{};
         uint32_t depth{};
         std::shared_ptr<PrincipalVariationTable> pvTable{};
     };
@@ -34,98 +42,138 @@ namespace ModernChess
     class Evaluation
     {
     public:
-        explicit Evaluation(GameState gameState) :
-                Evaluation(gameState, []{ return false; })
-        {}
-
-        explicit Evaluation(GameState gameState, std::function<bool()> stopSearching) :
+        /**
+         * @brief The search can't be stopped and always reaches the requested depth
+         * @param transpositionTable Is owned by the caller, so it is kept between searches and can be shared
+         *                           between search threads
+         * @param positionHistory Positions of the game up to the game state for detecting repetitions
+         */
+        explicit Evaluation(GameState gameState,
+                            TranspositionTable &transpositionTable,
+                            PositionHistory positionHistory = PositionHistory()) :
                 m_gameState{gameState},
-                m_halfMoveClockRootSearch{m_gameState.halfMoveClock},
-                pvTable{std::make_shared<PrincipalVariationTable>(m_halfMoveClockRootSearch)},
-                m_stopSearching{std::move(stopSearching)}
-        {}
+                m_transpositionTable{transpositionTable},
+                m_positionHistory{std::move(positionHistory)},
+                pvTable{std::make_shared<PrincipalVariationTable>()}
+        {
+            m_gameStateCopies.reserve(MaxPly);
+
+            // The history has to end with the root position
+            if (m_positionHistory.isEmpty() or m_positionHistory.getCurrentHash() != m_gameState.gameStateHash)
+            {
+                m_positionHistory.clear();
+                m_positionHistory.push(m_gameState.gameStateHash, true);
+            }
+        }
+
+        /**
+         * @param stopSignal Is polled during the search. Its deadline is checked every N nodes.
+         */
+        explicit Evaluation(GameState gameState,
+                            TranspositionTable &transpositionTable,
+                            StopSignal &stopSignal,
+                            PositionHistory positionHistory = PositionHistory()) :
+                Evaluation(gameState, transpositionTable, std::move(positionHistory))
+        {
+            m_stopSignal = &stopSignal;
+        }
 
         [[nodiscard]] EvaluationResult getBestMove(uint8_t depth);
 
+        /**
+         * @brief The pseudo legal move generation is kept for comparing both move generators in benchmarks.
+         */
+        void setMoveGenerationMode(MoveGenerationMode moveGenerationMode)
+        {
+            m_moveGenerationMode = moveGenerationMode;
+        }
+
+        /**
+         * @brief Copy-make is kept for comparing it with make-unmake in benchmarks.
+         */
+        void setMoveUndoMode(MoveUndoMode moveUndoMode)
+        {
+            m_moveUndoMode = moveUndoMode;
+        }
+
     protected:
         // Use half of max number in order to avoid overflows
         static constexpr int32_t Infinity = std::numeric_limits<int32_t>::max() / 2;
         static constexpr int32_t CheckMateScore = -Infinity + 1;
         static constexpr int32_t StaleMateScore = 0;
-        static constexpr int32_t BestKillerMoveScore = 90'000;
-        static constexpr int32_t SecondBestKillerMoveScore = 80'000;
-        static constexpr int32_t CaptureScoreOffset = 100'000;
-        static constexpr int32_t PvScore = 200'000;
-        static constexpr size_t MaxNumberOfKillerMoves = 2;
+        static constexpr int32_t DrawScore = 0;
+        static constexpr int32_t FiftyMoveRuleHalfMoves = 100;
         static constexpr int32_t NumberOfMovesForFullDepthSearch = 3;
         static constexpr uint32_t NumberOfFiguresForEndGameDefinition = 6;
         static constexpr uint8_t MinimumDepthForFullDepthSearch = 2;
         static constexpr uint8_t NullMovePruningDepthReduction = 2;
 
-        uint32_t m_numberOfNodes{};
+        uint64_t m_numberOfNodes{};
         GameState m_gameState;
-        int32_t m_halfMoveClockRootSearch{};
+        TranspositionTable &m_transpositionTable;
+        // positions of the game and of the searched moves
+        PositionHistory m_positionHistory;
+        // half moves from the root of the search. It is independent of the length of the game.
+        int32_t m_ply{};
         std::shared_ptr<PrincipalVariationTable> pvTable{};
-        // killer moves [id][ply]
-        std::array<std::array<Move, MaxNumberOfKillerMoves>, MaxHalfMoves> m_killerMoves{};
+        // killer moves [ply][id]
+        std::array<MovePicker::KillerMoves, MaxPly> m_killerMoves{};
         // history moves [figure][square]
-        std::array<std::array<int32_t, NumberOfFigureTypes>, NumberOfSquares> m_historyMoves{};
-        std::function<bool()> m_stopSearching{};
+        MovePicker::HistoryMoves m_historyMoves{};
+        StopSignal *m_stopSignal = nullptr;
+        uint64_t m_numberOfNodesAtTimeCheck{};
 
-        // follow PV & score PV move
+        // follow PV
         bool m_followPv{};
-        bool m_scorePv{};
 
         bool m_allowNullMove = true;
 
+        MoveGenerationMode m_moveGenerationMode = MoveGenerationMode::Legal;
+
+        MoveUndoMode m_moveUndoMode = MoveUndoMode::MakeUnmake;
+
+        // Stack of the game states before the moves, which are currently searched. Only used for copy-make.
+        std::vector<GameState> m_gameStateCopies;
+
+        /**
+         * @brief Reads the clock only every N nodes. Otherwise only the atomic stop flag is read.
+         */
+        [[nodiscard]] bool searchHasBeenStopped();
+
         [[nodiscard]] bool kingIsInCheck() const;
         [[nodiscard]] bool kingIsInCheck(Color sideToMove) const;
 
-        [[nodiscard]] std::vector<Move> generateSortedMoves();
+        /**
+         * @param undoRecord Takes the move back with undoMove(), if the move has been made
+         * @return false, if the move has not been made, because it is illegal or not of the given move type
+         */
+        [[nodiscard]] bool makeMove(Move move, MoveType moveType, UndoRecord &undoRecord);
+
+        void undoMove(Move move, const UndoRecord &undoRecord);
+
+        [[nodiscard]] UndoRecord makeNullMove();
+
+        void undoNullMove(const UndoRecord &undoRecord);
 
         // negamax alpha beta search
         [[nodiscard]] int32_t negamax(int32_t alpha, int32_t beta, uint8_t depth);
 
         [[nodiscard]] int32_t quiescenceSearch(int32_t alpha, int32_t beta);
 
-        [[nodiscard]] int32_t evaluatePosition() const;
-
-        [[nodiscard]] int32_t scoreMove(Move move);
-
-        [[nodiscard]] bool isEndGame() const;
+        /**
+         * @brief Appends the best moves of the transposition table to a PV, which has been truncated by a cutoff
+         *        of the transposition table
+         */
+        void completePrincipalVariation(uint8_t depth);
 
-        /*
-         * @see https://www.chessprogramming.org/MVV-LVA
-         *
-         *   (Victims) Pawn Knight Bishop   Rook  Queen   King
-         *
-         * (Attackers)
-         *       Pawn   105    205    305    405    505    605
-         *     Knight   104    204    304    404    504    604
-         *     Bishop   103    203    303    403    503    603
-         *       Rook   102    202    302    402    502    602
-         *      Queen   101    201    301    401    501    601
-         *       King   100    200    300    400    500    600
+        /**
+         * @brief Scores a position, in which the fifty-move rule applies
          */
+        [[nodiscard]] int32_t scoreFiftyMoveRule() const;
 
-        // most valuable victim & less valuable attacker [attacker][victim]
-        static constexpr std::array<std::array<int32_t, NumberOfFigureTypes>, NumberOfFigureTypes> mvvLva {
-            {
-                {105, 205, 305, 405, 505, 605,  105, 205, 305, 405, 505, 605},
-                {104, 204, 304, 404, 504, 604,  104, 204, 304, 404, 504, 604},
-                {103, 203, 303, 403, 503, 603,  103, 203, 303, 403, 503, 603},
-                {102, 202, 302, 402, 502, 602,  102, 202, 302, 402, 502, 602},
-                {101, 201, 301, 401, 501, 601,  101, 201, 301, 401, 501, 601},
-                {100, 200, 300, 400, 500, 600,  100, 200, 300, 400, 500, 600},
-
-                {105, 205, 305, 405, 505, 605,  105, 205, 305, 405, 505, 605},
-                {104, 204, 304, 404, 504, 604,  104, 204, 304, 404, 504, 604},
-                {103, 203, 303, 403, 503, 603,  103, 203, 303, 403, 503, 603},
-                {102, 202, 302, 402, 502, 602,  102, 202, 302, 402, 502, 602},
-                {101, 201, 301, 401, 501, 601,  101, 201, 301, 401, 501, 601},
-                {100, 200, 300, 400, 500, 600,  100, 200, 300, 400, 500, 600}
-            }
-        };
+        [[nodiscard]] int32_t evaluatePosition() const;
+
+        [[nodiscard]] bool isEndGame() const;
 
         /*
          *   Material Score
@@ -22,13 +22,13 @@ namespace ModernChess {
     };
 
     // This makes it possible to use Figure in for-loops
-    inline Figure &operator++(Figure &state)
+    constexpr Figure &operator++(Figure &state)
     {
         state = Figure(uint8_t(state) + 1);
         return state;
     }
 
-    inline Figure &operator--(Figure &state)
+    constexpr Figure &operator--(Figure &state)
     {
         state = Figure(uint8_t(state) - 1);
         return state;
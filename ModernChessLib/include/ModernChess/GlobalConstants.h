@@ -4,7 +4,14 @@
 
 namespace ModernChess
 {
-    static constexpr uint16_t MaxHalfMoves = 256; ///< Or max number of ply
+    static constexpr uint16_t MaxPly = 256; ///< Max search depth in half moves from the root of the search
     static constexpr uint8_t NumberOfFigureTypes = 12;
     static constexpr uint8_t NumberOfSquares = 64;
+    static constexpr uint8_t MaxNumberOfFiguresPerColor = 16; ///< Promotions only replace pawns
+    /**
+     * Max number of pseudo legal moves in any position with at most MaxNumberOfFiguresPerColor figures per color:
+     * 8 king moves, 2 castling moves and at most 27 moves of every other figure (a queen in the center).
+     * A promoting pawn has only 12 moves. The max number of legal moves in a reachable position is 218.
+     */
+    static constexpr uint16_t MaxNumberOfMoves = 8 + 2 + (MaxNumberOfFiguresPerColor - 1) * 27;
 }
\ No newline at end of file
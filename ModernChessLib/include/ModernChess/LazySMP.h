@@ -0,0 +1,68 @@
+#pragma once
+
+#include "Evaluation.h"
+#include "GameState.h"
+#include "PositionHistory.h"
+#include "StopSignal.h"
+#include "TranspositionTable.h"
+
+#include <atomic>
+#include <cinttypes>
+#include <functional>
+
+namespace ModernChess
+{
+    /**
+     * @brief Searches the same root position on several threads. Every thread owns its own Evaluation, i.e. its own
+     *        killer moves, history moves and PV table. The threads only communicate through the shared
+     *        transposition table. Helper threads with an odd id search one ply deeper than the main thread,
+     *        so the threads don't search the same tree in the same order.
+     *        The result of the main thread is reported.
+     * @see https://www.chessprogramming.org/Lazy_SMP
+     */
+    class LazySMP
+    {
+    public:
+        using ReportIteration = std::function<void(const EvaluationResult&)>;
+
+        static constexpr size_t MaxNumberOfThreads = 256;
+
+        /**
+         * @param transpositionTable Is shared by all threads. It is not cleared before a search, so the results
+         *                           of previous searches of the same game are reused.
+         * @param numberOfThreads Number of threads including the main thread
+         */
+        explicit LazySMP(TranspositionTable &transpositionTable, size_t numberOfThreads = 1);
+
+        /**
+         * @brief Searches with iterative deepening up to the given depth
+         * @param positionHistory Positions of the game up to the game state for detecting repetitions
+         * @param stopSignal Stops the search of all threads. It is also stopped by the main thread, when it has
+         *                   finished its search, so the helper threads stop, too.
+         * @param reportIteration Is called by the main thread after every iteration. The number of nodes of the
+         *                        result includes the nodes of the helper threads.
+         * @return The result of the last iteration of the main thread
+         */
+        [[nodiscard]] EvaluationResult search(const GameState &gameState,
+                                              const PositionHistory &positionHistory,
+                                              uint8_t depth,
+                                              StopSignal &stopSignal,
+                                              const ReportIteration &reportIteration = [](const EvaluationResult&){});
+
+        [[nodiscard]] size_t numberOfThreads() const
+        {
+            return m_numberOfThreads;
+        }
+
+    private:
+        TranspositionTable &m_transpositionTable;
+        size_t m_numberOfThreads;
+        std::atomic<uint64_t> m_numberOfHelperNodes{};
+
+        void searchAsHelper(const GameState &gameState,
+                            const PositionHistory &positionHistory,
+                            uint8_t depth,
+                            size_t helperId,
+                            StopSignal &stopSignal);
+    };
+}
@@ -0,0 +1,506 @@
+#pragma once
+
+#include "PseudoMoveGeneration.h"
+
+namespace ModernChess
+{
+    /**
+     * @brief Checks and pins of the side to move. It is computed only once per position.
+     */
+    struct CheckInfo
+    {
+        Square kingSquare = Square::undefined;
+        // opponent figures, which are giving check
+        BitBoardState checkers = BoardState::empty;
+        // own figures, which are pinned to the own king
+        BitBoardState pinnedFigures = BoardState::empty;
+        // allowed target squares of non-king moves, i.e. capturing the checker or blocking the check
+        BitBoardState checkMask = BoardState::allSquaresOccupied;
+
+        [[nodiscard]] bool isInCheck() const
+        {
+            return checkers != BoardState::empty;
+        }
+
+        [[nodiscard]] bool isInDoubleCheck() const
+        {
+            return (checkers & (checkers - 1)) != BoardState::empty;
+        }
+    };
+
+    /**
+     * @brief Generates only legal moves. In contrast to the PseudoMoveGeneration, a move doesn't have to be
+     *        taken back, because it has exposed the king into a check.
+     * @see https://www.chessprogramming.org/Move_Generation#Legal
+     */
+    class LegalMoveGeneration
+    {
+    public:
+        LegalMoveGeneration() = delete;
+
+        /**
+         * @tparam category e.g. only captures for the quiescence search
+         */
+        template<MoveCategory category = MoveCategory::AllMoves>
+        [[nodiscard]] static MoveList generateMoves(const GameState &gameState)
+        {
+            MoveList movesToBeGenerated;
+            generateMoves<category>(gameState, movesToBeGenerated);
+
+            return movesToBeGenerated;
+        }
+
+        /**
+         * @brief Appends the generated moves to the given move list
+         */
+        template<MoveCategory category = MoveCategory::AllMoves>
+        static void generateMoves(const GameState &gameState, MoveList &movesToBeGenerated)
+        {
+            static_assert(category != MoveCategory::Evasions, "Legal moves are evasions anyway, if the king is in check");
+
+            if (gameState.board.sideToMove == Color::White)
+            {
+                generateFigureMoves<Color::White, category>(gameState, movesToBeGenerated);
+            }
+            else
+            {
+                generateFigureMoves<Color::Black, category>(gameState, movesToBeGenerated);
+            }
+        }
+
+        [[nodiscard]] static CheckInfo getCheckInfo(const GameState &gameState)
+        {
+            if (gameState.board.sideToMove == Color::White)
+            {
+                return getCheckInfo<Color::White>(gameState.board);
+            }
+
+            return getCheckInfo<Color::Black>(gameState.board);
+        }
+
+        /**
+         * @brief Checks the legality of a pseudo legal move, e.g. of a move from the PseudoMoveGeneration
+         * @param checkInfo has to belong to the given game state
+         */
+        [[nodiscard]] static bool isLegal(const GameState &gameState, const CheckInfo &checkInfo, Move move)
+        {
+            if (gameState.board.sideToMove == Color::White)
+            {
+                return isLegal<Color::White>(gameState.board, checkInfo, move);
+            }
+
+            return isLegal<Color::Black>(gameState.board, checkInfo, move);
+        }
+
+    private:
+        template<Color color>
+        static constexpr Color opponentOf()
+        {
+            return PseudoMoveGeneration::opponentOf<color>();
+        }
+
+        template<Color color>
+        static constexpr Figure figureOf(Figure whiteFigure)
+        {
+            return PseudoMoveGeneration::figureOf<color>(whiteFigure);
+        }
+
+        template<Color color>
+        [[nodiscard]] static CheckInfo getCheckInfo(const Board &board)
+        {
+            constexpr Color opponentsColor = opponentOf<color>();
+            constexpr Figure opponentsBishop = figureOf<opponentsColor>(Figure::WhiteBishop);
+            constexpr Figure opponentsRook = figureOf<opponentsColor>(Figure::WhiteRook);
+            constexpr Figure opponentsQueen = figureOf<opponentsColor>(Figure::WhiteQueen);
+
+            CheckInfo checkInfo;
+            checkInfo.kingSquare = BitBoardOperations::bitScanForward(board.bitboards[figureOf<color>(Figure::WhiteKing)]);
+            checkInfo.checkers = AttackQueries::attackersOfSquare<opponentsColor>(board, checkInfo.kingSquare,
+                                                                                  board.occupancies[Color::Both]);
+
+            if (checkInfo.isInDoubleCheck())
+            {
+                // Only the king is able to resolve a double check
+                checkInfo.checkMask = BoardState::empty;
+            }
+            else if (checkInfo.isInCheck())
+            {
+                const Square checkerSquare = BitBoardOperations::bitScanForward(checkInfo.checkers);
+                checkInfo.checkMask = checkInfo.checkers | AttackQueries::squaresBetween[checkInfo.kingSquare][checkerSquare];
+            }
+
+            // Opponent sliders, which would attack the king on an empty board
+            BitBoardState snipers =
+                    (AttackQueries::rookAttacks.getAttacks(checkInfo.kingSquare, BoardState::empty) &
+                     (board.bitboards[opponentsRook] | board.bitboards[opponentsQueen])) |
+                    (AttackQueries::bishopAttacks.getAttacks(checkInfo.kingSquare, BoardState::empty) &
+                     (board.bitboards[opponentsBishop] | board.bitboards[opponentsQueen]));
+
+            while (snipers != BoardState::empty)
+            {
+                const Square sniperSquare = BitBoardOperations::bitScanForward(snipers);
+                const BitBoardState blockers = AttackQueries::squaresBetween[checkInfo.kingSquare][sniperSquare] &
+                                               board.occupancies[Color::Both];
+
+                // A single own figure between king and sniper is pinned
+                if (blockers != BoardState::empty && (blockers & (blockers - 1)) == BoardState::empty)
+                {
+                    checkInfo.pinnedFigures |= blockers & board.occupancies[color];
+                }
+
+                snipers = BitBoardOperations::eraseSquare(snipers, sniperSquare);
+            }
+
+            return checkInfo;
+        }
+
+        template<Color color, MoveCategory category>
+        static void generateFigureMoves(const GameState &gameState, MoveList &movesToBeGenerated)
+        {
+            const CheckInfo checkInfo = getCheckInfo<color>(gameState.board);
+
+            if (checkInfo.isInDoubleCheck())
+            {
+                if constexpr (category != MoveCategory::Promotions)
+                {
+                    generateKingMoves<color, category>(gameState, checkInfo, movesToBeGenerated);
+                }
+                return;
+            }
+
+            // Keep the same order as the pseudo move generation
+            generatePawnMoves<color, category>(gameState, checkInfo, movesToBeGenerated);
+
+            // Only pawns are able to promote
+            if constexpr (category != MoveCategory::Promotions)
+            {
+                generateKingMoves<color, category>(gameState, checkInfo, movesToBeGenerated);
+                generatePieceMoves<color, figureOf<color>(Figure::WhiteKnight), category>(gameState, checkInfo, movesToBeGenerated);
+                generatePieceMoves<color, figureOf<color>(Figure::WhiteBishop), category>(gameState, checkInfo, movesToBeGenerated);
+                generatePieceMoves<color, figureOf<color>(Figure::WhiteRook), category>(gameState, checkInfo, movesToBeGenerated);
+                generatePieceMoves<color, figureOf<color>(Figure::WhiteQueen), category>(gameState, checkInfo, movesToBeGenerated);
+            }
+        }
+
+        template<Color color, MoveCategory category>
+        static void generatePawnMoves(const GameState &gameState, const CheckInfo &checkInfo, MoveList &movesToBeGenerated)
+        {
+            constexpr bool generateCaptures = (category == MoveCategory::AllMoves || category == MoveCategory::Captures);
+            constexpr bool generatePromotions = (category == MoveCategory::AllMoves || category == MoveCategory::Promotions);
+            constexpr bool generatePushes = (category == MoveCategory::AllMoves || category == MoveCategory::QuietMoves);
+
+            constexpr Color opponentsColor = opponentOf<color>();
+            constexpr Figure pawn = figureOf<color>(Figure::WhitePawn);
+
+            // White pawns are moving towards north direction and black pawns towards south direction
+            constexpr auto pushSquare = [](Square square) {
+                return (color == Color::White) ? BitBoardOperations::getNorthSquareFromGivenSquare(square) :
+                                                 BitBoardOperations::getSouthSquareFromGivenSquare(square);
+            };
+
+            // Pawns on these ranks promote on their next move or are able to do a double pawn push
+            constexpr Square promotionRankStart = (color == Color::White) ? Square::a7 : Square::a2;
+            constexpr Square promotionRankEnd = (color == Color::White) ? Square::h7 : Square::h2;
+            constexpr Square doublePushRankStart = (color == Color::White) ? Square::a2 : Square::a7;
+            constexpr Square doublePushRankEnd = (color == Color::White) ? Square::h2 : Square::h7;
+
+            const BitBoardState occupancy = gameState.board.occupancies[Color::Both];
+
+            BitBoardState pawnBitboard = gameState.board.bitboards[pawn];
+
+            if constexpr (category == MoveCategory::Promotions)
+            {
+                // Only pawns, which are one step before the promotion
+                pawnBitboard &= (color == Color::White) ? BitBoardConstants::rank7 : BitBoardConstants::rank2;
+            }
+
+            // loop over pawns within pawn bitboard
+            while (pawnBitboard != BoardState::empty)
+            {
+                const Square sourceSquare = BitBoardOperations::bitScanForward(pawnBitboard);
+                const bool isPromotion = (sourceSquare >= promotionRankStart && sourceSquare <= promotionRankEnd);
+
+                // A pinned pawn may only move along the line between king and pinner
+                BitBoardState targetMask = checkInfo.checkMask;
+
+                if (BitBoardOperations::isOccupied(checkInfo.pinnedFigures, sourceSquare))
+                {
+                    targetMask &= AttackQueries::lines[checkInfo.kingSquare][sourceSquare];
+                }
+
+                if (isPromotion ? generatePromotions : generatePushes)
+                {
+                    // generate quite pawn moves
+                    const Square targetSquare = pushSquare(sourceSquare);
+
+                    const bool targetSquareIsOnBoard = (color == Color::White) ? (targetSquare <= Square::h8) :
+                                                                                 (targetSquare >= Square::a1);
+
+                    if (targetSquareIsOnBoard && !BitBoardOperations::isOccupied(occupancy, targetSquare))
+                    {
+                        if (BitBoardOperations::isOccupied(targetMask, targetSquare))
+                        {
+                            if (isPromotion)
+                            {
+                                PseudoMoveGeneration::addPromotions<color>(movesToBeGenerated, sourceSquare,
+                                                                           targetSquare, false);
+                            }
+                            else
+                            {
+                                movesToBeGenerated.emplace_back(sourceSquare, targetSquare, pawn, Figure::None,
+                                                                false, false, false, false);
+                            }
+                        }
+
+                        // double pawn push. It might block a check, even if the single push doesn't.
+                        if ((sourceSquare >= doublePushRankStart && sourceSquare <= doublePushRankEnd) &&
+                            !BitBoardOperations::isOccupied(occupancy, pushSquare(targetSquare)) &&
+                            BitBoardOperations::isOccupied(targetMask, pushSquare(targetSquare)))
+                        {
+                            movesToBeGenerated.emplace_back(sourceSquare, pushSquare(targetSquare), pawn,
+                                                            Figure::None, false, true, false, false);
+                        }
+                    }
+                }
+
+                if constexpr (generateCaptures)
+                {
+                    // generate pawn captures
+                    for (BitBoardState attacks = AttackQueries::pawnAttackTable[color][sourceSquare] &
+                                                 gameState.board.occupancies[opponentsColor] & targetMask;
+                         attacks != BoardState::empty;
+                            )
+                    {
+                        const Square targetSquare = BitBoardOperations::bitScanForward(attacks);
+
+                        if (isPromotion)
+                        {
+                            PseudoMoveGeneration::addPromotions<color>(movesToBeGenerated, sourceSquare, targetSquare, true);
+                        }
+                        else
+                        {
+                            movesToBeGenerated.emplace_back(sourceSquare, targetSquare, pawn, Figure::None,
+                                                            true, false, false, false);
+                        }
+
+                        attacks = BitBoardOperations::eraseSquare(attacks, targetSquare);
+                    }
+
+                    // generate en passant captures
+                    if (gameState.board.enPassantTarget != Square::undefined &&
+                        BitBoardOperations::isOccupied(AttackQueries::pawnAttackTable[color][sourceSquare],
+                                                       gameState.board.enPassantTarget) &&
+                        enPassantCaptureIsLegal<color>(gameState.board, checkInfo.kingSquare, sourceSquare,
+                                                       gameState.board.enPassantTarget))
+                    {
+                        movesToBeGenerated.emplace_back(sourceSquare, gameState.board.enPassantTarget, pawn, Figure::None,
+                                                        true, false, true, false);
+                    }
+                }
+
+                // pop ls1b from figure pawnBitboard copy
+                pawnBitboard = BitBoardOperations::eraseSquare(pawnBitboard, sourceSquare);
+            }
+        }
+
+        /**
+         * @brief An en passant capture removes two pawns from the same rank. Therefore, simply replay the capture
+         *        on the occupancy and check, whether the king is attacked afterwards.
+         */
+        template<Color color>
+        [[nodiscard]] static bool enPassantCaptureIsLegal(const Board &board, Square kingSquare,
+                                                          Square sourceSquare, Square targetSquare)
+        {
+            constexpr Color opponentsColor = opponentOf<color>();
+
+            // The captured pawn is always one behind the en passant target square
+            const Square capturedPawnSquare = (color == Color::White) ?
+                                              BitBoardOperations::getSouthSquareFromGivenSquare(targetSquare) :
+                                              BitBoardOperations::getNorthSquareFromGivenSquare(targetSquare);
+
+            BitBoardState occupancy = board.occupancies[Color::Both];
+            occupancy = BitBoardOperations::eraseSquare(occupancy, sourceSquare);
+            occupancy = BitBoardOperations::eraseSquare(occupancy, capturedPawnSquare);
+            occupancy = BitBoardOperations::occupySquare(occupancy, targetSquare);
+
+            // The captured pawn cannot attack the king anymore
+            const BitBoardState attackers = AttackQueries::attackersOfSquare<opponentsColor>(board, kingSquare, occupancy) &
+                                            ~BitBoardOperations::occupySquare(BoardState::empty, capturedPawnSquare);
+
+            return attackers == BoardState::empty;
+        }
+
+        template<Color color, MoveCategory category>
+        static void generateKingMoves(const GameState &gameState, const CheckInfo &checkInfo, MoveList &movesToBeGenerated)
+        {
+            constexpr Color opponentsColor = opponentOf<color>();
+            constexpr Figure king = figureOf<color>(Figure::WhiteKing);
+
+            const Board &board = gameState.board;
+
+            // castling moves are quiet moves
+            if constexpr (category == MoveCategory::AllMoves || category == MoveCategory::QuietMoves)
+            {
+                if (not checkInfo.isInCheck())
+                {
+                    generateCastlingMoves<color>(gameState, movesToBeGenerated);
+                }
+            }
+
+            // Remove the king from the occupancy, otherwise it would hide squares behind itself from sliding attacks
+            const BitBoardState occupancyWithoutKing = BitBoardOperations::eraseSquare(board.occupancies[Color::Both],
+                                                                                       checkInfo.kingSquare);
+
+            BitBoardState targets = AttackQueries::kingAttackTable[checkInfo.kingSquare] &
+                                    PseudoMoveGeneration::getTargetMask<color, category>(board);
+            BitBoardState safeTargets = BoardState::empty;
+
+            while (targets != BoardState::empty)
+            {
+                const Square targetSquare = BitBoardOperations::bitScanForward(targets);
+
+                if (not AttackQueries::squareIsAttacked<opponentsColor>(board, targetSquare, occupancyWithoutKing))
+                {
+                    safeTargets = BitBoardOperations::occupySquare(safeTargets, targetSquare);
+                }
+
+                targets = BitBoardOperations::eraseSquare(targets, targetSquare);
+            }
+
+            PseudoMoveGeneration::addPieceMoves<color, king>(gameState, movesToBeGenerated, checkInfo.kingSquare,
+                                                             safeTargets);
+        }
+
+        /**
+         * @precondition king is not in check
+         */
+        template<Color color>
+        static void generateCastlingMoves(const GameState &gameState, MoveList &movesToBeGenerated)
+        {
+            constexpr Color opponentsColor = opponentOf<color>();
+            constexpr Figure king = figureOf<color>(Figure::WhiteKing);
+
+            constexpr Square kingSquare = (color == Color::White) ? Square::e1 : Square::e8;
+            constexpr Square kingSideRookTarget = (color == Color::White) ? Square::f1 : Square::f8;
+            constexpr Square kingSideKingTarget = (color == Color::White) ? Square::g1 : Square::g8;
+            constexpr Square queenSideRookTarget = (color == Color::White) ? Square::d1 : Square::d8;
+            constexpr Square queenSideKingTarget = (color == Color::White) ? Square::c1 : Square::c8;
+            constexpr Square queenSideKnightSquare = (color == Color::White) ? Square::b1 : Square::b8;
+
+            const Board &board = gameState.board;
+            const BitBoardState occupancy = board.occupancies[Color::Both];
+
+            const bool canCastleKingSide = (color == Color::White) ?
+                                           whiteCanCastleKingSide(board.castlingRights) :
+                                           blackCanCastleKingSide(board.castlingRights);
+            const bool canCastleQueenSide = (color == Color::White) ?
+                                            whiteCanCastleQueenSide(board.castlingRights) :
+                                            blackCanCastleQueenSide(board.castlingRights);
+
+            // The squares between king and rook must be empty and the king must not pass or land on an attacked square
+            if (canCastleKingSide &&
+                !BitBoardOperations::isOccupied(occupancy, kingSideRookTarget) &&
+                !BitBoardOperations::isOccupied(occupancy, kingSideKingTarget) &&
+                !AttackQueries::squareIsAttacked<opponentsColor>(board, kingSideRookTarget, occupancy) &&
+                !AttackQueries::squareIsAttacked<opponentsColor>(board, kingSideKingTarget, occupancy))
+            {
+                movesToBeGenerated.emplace_back(kingSquare, kingSideKingTarget, king, Figure::None, false,
+                                                false, false, true);
+            }
+
+            if (canCastleQueenSide &&
+                !BitBoardOperations::isOccupied(occupancy, queenSideRookTarget) &&
+                !BitBoardOperations::isOccupied(occupancy, queenSideKingTarget) &&
+                !BitBoardOperations::isOccupied(occupancy, queenSideKnightSquare) &&
+                !AttackQueries::squareIsAttacked<opponentsColor>(board, queenSideRookTarget, occupancy) &&
+                !AttackQueries::squareIsAttacked<opponentsColor>(board, queenSideKingTarget, occupancy))
+            {
+                movesToBeGenerated.emplace_back(kingSquare, queenSideKingTarget, king, Figure::None, false,
+                                                false, false, true);
+            }
+        }
+
+        template<Color color, Figure piece, MoveCategory category>
+        static void generatePieceMoves(const GameState &gameState, const CheckInfo &checkInfo, MoveList &movesToBeGenerated)
+        {
+            const BitBoardState targetMask = PseudoMoveGeneration::getTargetMask<color, category>(gameState.board) &
+                                             checkInfo.checkMask;
+
+            BitBoardState pieceBitboard = gameState.board.bitboards[piece];
+
+            if constexpr (piece == Figure::WhiteKnight || piece == Figure::BlackKnight)
+            {
+                // A pinned knight is never able to stay on the pin line
+                pieceBitboard &= ~checkInfo.pinnedFigures;
+            }
+
+            while (pieceBitboard != BoardState::empty)
+            {
+                const Square sourceSquare = BitBoardOperations::bitScanForward(pieceBitboard);
+
+                BitBoardState attacks = PseudoMoveGeneration::getPieceAttacks<piece>(sourceSquare,
+                                                                                     gameState.board.occupancies[Color::Both]) &
+                                        targetMask;
+
+                // A pinned figure may only move along the line between king and pinner
+                if (BitBoardOperations::isOccupied(checkInfo.pinnedFigures, sourceSquare))
+                {
+                    attacks &= AttackQueries::lines[checkInfo.kingSquare][sourceSquare];
+                }
+
+                PseudoMoveGeneration::addPieceMoves<color, piece>(gameState, movesToBeGenerated, sourceSquare, attacks);
+
+                pieceBitboard = BitBoardOperations::eraseSquare(pieceBitboard, sourceSquare);
+            }
+        }
+
+        template<Color color>
+        [[nodiscard]] static bool isLegal(const Board &board, const CheckInfo &checkInfo, Move move)
+        {
+            constexpr Color opponentsColor = opponentOf<color>();
+            constexpr Figure king = figureOf<color>(Figure::WhiteKing);
+
+            const Square sourceSquare = move.getFrom();
+            const Square targetSquare = move.getTo();
+
+            if (move.getMovedFigure() == king)
+            {
+                if (move.isCastlingMove())
+                {
+                    // The king must neither castle out of a check, nor pass or land on an attacked square
+                    const Square passedSquare = Square((sourceSquare + targetSquare) / 2);
+
+                    return not checkInfo.isInCheck() &&
+                           !AttackQueries::squareIsAttacked<opponentsColor>(board, passedSquare, board.occupancies[Color::Both]) &&
+                           !AttackQueries::squareIsAttacked<opponentsColor>(board, targetSquare, board.occupancies[Color::Both]);
+                }
+
+                const BitBoardState occupancyWithoutKing = BitBoardOperations::eraseSquare(board.occupancies[Color::Both],
+                                                                                           sourceSquare);
+                return !AttackQueries::squareIsAttacked<opponentsColor>(board, targetSquare, occupancyWithoutKing);
+            }
+
+            if (checkInfo.isInDoubleCheck())
+            {
+                return false;
+            }
+
+            if (move.isEnPassantCapture())
+            {
+                return enPassantCaptureIsLegal<color>(board, checkInfo.kingSquare, sourceSquare, targetSquare);
+            }
+
+            if (!BitBoardOperations::isOccupied(checkInfo.checkMask, targetSquare))
+            {
+                return false;
+            }
+
+            if (BitBoardOperations::isOccupied(checkInfo.pinnedFigures, sourceSquare))
+            {
+                return BitBoardOperations::isOccupied(AttackQueries::lines[checkInfo.kingSquare][sourceSquare], targetSquare);
+            }
+
+            return true;
+        }
+    };
+}
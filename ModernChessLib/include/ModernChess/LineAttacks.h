@@ -0,0 +1,76 @@
+#pragma once
+
+#include "BishopAttacks.h"
+#include "RookAttacks.h"
+
+namespace ModernChess::Attacks {
+
+    /**
+     * @brief Pass two squares as indices for retrieving the squares in between them.
+     *        The given squares are excluded. The result is empty, if the squares are not on a common rank,
+     *        file, diagonal or anti-diagonal.
+     * @see https://www.chessprogramming.org/Square_Attacked_By#InBetween
+     * @return In-between map for every pair of squares
+     */
+    constexpr std::array<std::array<BitBoardState, 64>, 64> generateSquaresBetween()
+    {
+        std::array<std::array<BitBoardState, 64>, 64> squaresBetween{};
+
+        for (Square from = Square::a1; from <= Square::h8; ++from)
+        {
+            for (Square to = Square::a1; to <= Square::h8; ++to)
+            {
+                const BitBoardState fromState = BitBoardOperations::occupySquare(BoardState::empty, from);
+                const BitBoardState toState = BitBoardOperations::occupySquare(BoardState::empty, to);
+
+                if ((RookAttackHelperFunctions::rookAttacksOnTheFly(BoardState::empty, from) & toState) != BoardState::empty)
+                {
+                    squaresBetween[from][to] = RookAttackHelperFunctions::rookAttacksOnTheFly(toState, from) &
+                                               RookAttackHelperFunctions::rookAttacksOnTheFly(fromState, to);
+                }
+                else if ((BishopAttackHelperFunctions::bishopAttacksOnTheFly(BoardState::empty, from) & toState) != BoardState::empty)
+                {
+                    squaresBetween[from][to] = BishopAttackHelperFunctions::bishopAttacksOnTheFly(toState, from) &
+                                               BishopAttackHelperFunctions::bishopAttacksOnTheFly(fromState, to);
+                }
+            }
+        }
+
+        return squaresBetween;
+    }
+
+    /**
+     * @brief Pass two squares as indices for retrieving the complete line (from board edge to board edge)
+     *        through both squares. The result is empty, if the squares are not on a common rank,
+     *        file, diagonal or anti-diagonal.
+     * @return Line map for every pair of squares
+     */
+    constexpr std::array<std::array<BitBoardState, 64>, 64> generateLines()
+    {
+        std::array<std::array<BitBoardState, 64>, 64> lines{};
+
+        for (Square from = Square::a1; from <= Square::h8; ++from)
+        {
+            for (Square to = Square::a1; to <= Square::h8; ++to)
+            {
+                const BitBoardState fromState = BitBoardOperations::occupySquare(BoardState::empty, from);
+                const BitBoardState toState = BitBoardOperations::occupySquare(BoardState::empty, to);
+
+                if ((RookAttackHelperFunctions::rookAttacksOnTheFly(BoardState::empty, from) & toState) != BoardState::empty)
+                {
+                    lines[from][to] = (RookAttackHelperFunctions::rookAttacksOnTheFly(BoardState::empty, from) &
+                                       RookAttackHelperFunctions::rookAttacksOnTheFly(BoardState::empty, to)) |
+                                      fromState | toState;
+                }
+                else if ((BishopAttackHelperFunctions::bishopAttacksOnTheFly(BoardState::empty, from) & toState) != BoardState::empty)
+                {
+                    lines[from][to] = (BishopAttackHelperFunctions::bishopAttacksOnTheFly(BoardState::empty, from) &
+                                       BishopAttackHelperFunctions::bishopAttacksOnTheFly(BoardState::empty, to)) |
+                                      fromState | toState;
+                }
+            }
+        }
+
+        return lines;
+    }
+}
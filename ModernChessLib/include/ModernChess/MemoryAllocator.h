@@ -1,11 +1,35 @@
 #pragma once
 
+#include <cinttypes>
 #include <memory>
 #include <functional>
 #include <iostream>
+#include <string>
 
 namespace ModernChess
 {
+    enum class PageBacking : uint8_t {
+        ExplicitHugePages,     // reserved huge pages (MAP_HUGETLB)
+        TransparentHugePages,  // huge pages requested with madvise(), which the kernel might not grant
+        NormalPages
+    };
+
+    enum class NumaPolicy : uint8_t {
+        FirstTouch,            // a page is placed on the NUMA node of the thread, which touches it first
+        Interleave             // the pages are distributed round-robin across all NUMA nodes
+    };
+
+    /**
+     * @brief Describes the memory, which has actually been obtained for a large allocation
+     */
+    struct LargePageInfo {
+        PageBacking pageBacking = PageBacking::NormalPages;
+        // Number of bytes backed by huge pages. It is only known after the memory has been touched.
+        size_t hugePageBytes{};
+        size_t numberOfNumaNodes = 1;
+        bool isInterleaved{};
+    };
+
     /**
      * @brief Allocates aligned memory for better performance
      */
@@ -49,9 +73,82 @@ namespace ModernChess
 
             return std::unique_ptr<T[], std::function<void(T*)>>(ptr, deleter);
         }
+        /**
+         * @brief Allocates memory for a large table. Reserved huge pages are tried first, then transparent huge
+         *        pages and then normal pages.
+         * @param largePageInfo Is set to the backing, which has been obtained
+         * @return nullptr, if the memory can't be allocated. A table size is chosen by the user, so the caller
+         *         can fall back to a smaller table instead of terminating.
+         */
+        template<typename T>
+        [[nodiscard]] static std::unique_ptr<T[], std::function<void(T*)>> largePageArray(size_t allocSizeBytes,
+                                                                                          NumaPolicy numaPolicy,
+                                                                                          LargePageInfo &largePageInfo)
+        {
+            size_t mappedSizeBytes = 0;
+            T* ptr = static_cast<T*>(MemoryAllocator::largePageAllocRawPtr(allocSizeBytes, numaPolicy,
+                                                                           largePageInfo, mappedSizeBytes));
+
+            if (not ptr)
+            {
+                return nullptr;
+            }
+
+            std::function<void(T*)> deleter = [pageBacking = largePageInfo.pageBacking, mappedSizeBytes](T *ptr) {
+                MemoryAllocator::largePageFree((void*) ptr, pageBacking, mappedSizeBytes);
+            };
+
+            return std::unique_ptr<T[], std::function<void(T*)>>(ptr, deleter);
+        }
+
+        /**
+         * @return Number of bytes of the memory, which are backed by huge pages. Transparent huge pages are only
+         *         assigned when the memory is touched, so call it after the memory has been initialized.
+         */
+        [[nodiscard]] static size_t getHugePageBytes(const void *ptr, size_t sizeBytes);
+
+        /**
+         * @brief Maps a named POSIX shared memory segment, which can be mapped by other processes, too.
+         *        A new segment is created with the given size and is filled with zeros. An existing segment keeps
+         *        its size. The segment outlives the processes until it is removed by unlinkSharedMemory().
+         * @param created Is set to true, if the segment has been created by this call
+         * @return nullptr, if the segment can't be mapped or shared memory is not supported
+         */
+        [[nodiscard]] static void* mapSharedMemory(const std::string &name,
+                                                   size_t allocSizeBytes,
+                                                   size_t &mappedSizeBytes,
+                                                   bool &created);
+
+        /**
+         * @brief Removes the name of a shared memory segment. Existing mappings stay valid, but the next call of
+         *        mapSharedMemory() creates a new segment.
+         */
+        static void unlinkSharedMemory(const std::string &name);
+
+        /**
+         * @brief Maps a file copy-on-write. The pages are only read from the file, when they are accessed for the
+         *        first time. Changes are not written back to the file.
+         * @return nullptr, if the file can't be mapped or memory mapping is not supported
+         */
+        [[nodiscard]] static void* mapFile(const std::string &path, size_t &mappedSizeBytes);
+
+        /**
+         * @brief Unmaps shared memory or a file
+         */
+        static void unmapMemory(void* ptr, size_t mappedSizeBytes);
+
     private:
         static void* alignedAllocRawPtr(size_t allocSizeBytes);
 
+        static void* largePageAllocRawPtr(size_t allocSizeBytes,
+                                          NumaPolicy numaPolicy,
+                                          LargePageInfo &largePageInfo,
+                                          size_t &mappedSizeBytes);
+
+        static void largePageFree(void* ptr, PageBacking pageBacking, size_t mappedSizeBytes);
+
         static void alignedFree(void* ptr);
     };
-}
\ No newline at end of file
+}
+
+std::ostream &operator<<(std::ostream &os, ModernChess::PageBacking pageBacking);
\ No newline at end of file
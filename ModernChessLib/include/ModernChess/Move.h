@@ -94,6 +94,21 @@ namespace ModernChess {
             return m_move == 0;
         }
 
+        /**
+         * @return The binary move bits, which can be stored compactly, e.g. in the transposition table
+         */
+        [[nodiscard]] uint32_t getEncoding() const
+        {
+            return uint32_t(m_move);
+        }
+
+        [[nodiscard]] static Move fromEncoding(uint32_t encoding)
+        {
+            Move move;
+            move.m_move = int32_t(encoding);
+            return move;
+        }
+
         bool operator==(const Move &other) const = default;
 
     private:
@@ -12,118 +12,159 @@ namespace ModernChess
         CapturesOnly
     };
 
+    /**
+     * @brief How the game state is restored after a move has been searched
+     */
+    enum class MoveUndoMode
+    {
+        CopyMake,   ///< The complete game state is copied before the move is made
+        MakeUnmake  ///< The move is taken back incrementally with the help of an UndoRecord
+    };
+
+    /**
+     * @brief Holds the state, which can't be restored from the move itself, when a move is taken back.
+     * @see https://www.chessprogramming.org/Unmake_Move
+     */
+    struct UndoRecord
+    {
+        Figure capturedFigure = Figure::None;
+        Square enPassantTarget = Square::undefined;
+        CastlingRights castlingRights = CastlingRights::Gone;
+        uint64_t gameStateHash = 0;
+        int32_t halfMoveClock = 0;
+    };
+
     class MoveExecution
     {
     public:
         MoveExecution() = delete;
 
         static bool executeMove(GameState &gameState, Move move, MoveType moveType)
+        {
+            UndoRecord undoRecord;
+
+            return executeMove(gameState, move, moveType, undoRecord);
+        }
+
+        /**
+         * @param undoRecord Takes the move back with undoMove(), if the move has been made
+         * @return false, if the move has not been made, because it is illegal or not of the given move type.
+         *         The game state is unchanged in this case.
+         */
+        static bool executeMove(GameState &gameState, Move move, MoveType moveType, UndoRecord &undoRecord)
         {
             if (gameState.board.sideToMove == Color::White)
             {
-                return MoveExecution::executeMoveForWhite(gameState, move, moveType);
+                return executeMoveWithLegalityCheck<Color::White>(gameState, move, moveType, undoRecord);
             }
 
-            return MoveExecution::executeMoveForBlack(gameState, move, moveType);
+            return executeMoveWithLegalityCheck<Color::Black>(gameState, move, moveType, undoRecord);
         }
 
-        static bool executeMoveForWhite(GameState &gameState, Move move, MoveType moveType)
+        /**
+         * @brief Executes a move, which is known to be legal, e.g. from the LegalMoveGeneration.
+         *        In contrast to executeMove() the king is not checked for being exposed into a check.
+         * @return Takes the move back with undoMove()
+         */
+        static UndoRecord executeLegalMove(GameState &gameState, Move move)
         {
-            // make quiet or capture move
-            if (moveType == MoveType::AllMoves or move.isCapture())
+            if (gameState.board.sideToMove == Color::White)
             {
-                // preserve board state
-                const GameState gameStateCopy = gameState;
+                return makeMove<Color::White>(gameState, move);
+            }
 
-                // parse move
-                const Square sourceSquare = move.getFrom();
-                const Square targetSquare = move.getTo();
-                const Figure movedFigure = move.getMovedFigure();
-                const bool castling = move.isCastlingMove();
+            return makeMove<Color::Black>(gameState, move);
+        }
 
-                // handling capture moves
-                if (move.isCapture())
-                {
-                    removeCapturedFigure(gameState, Figure::BlackPawn, Figure::BlackKing, Color::Black, targetSquare);
-                }
+        /**
+         * @brief Takes back the last move, which has been made by executeMove() or executeLegalMove()
+         */
+        static void undoMove(GameState &gameState, Move move, const UndoRecord &undoRecord)
+        {
+            // The side to move is the opponent of the side, which has made the move
+            if (gameState.board.sideToMove == Color::Black)
+            {
+                unmakeMove<Color::White>(gameState, move, undoRecord);
+            }
+            else
+            {
+                unmakeMove<Color::Black>(gameState, move, undoRecord);
+            }
+        }
 
-                // Add the moved figure into bitboards after the potential capture has been removed, otherwise we
-                // would potentially remove the moved figure again, if we go the other way around
-                removeFromBitboards(gameState, movedFigure, Color::White, sourceSquare);
-                addToBitboards(gameState, movedFigure, Color::White, targetSquare);
+        /**
+         * @brief Passes the right to move to the opponent
+         * @see https://www.chessprogramming.org/Null_Move
+         * @return Takes the null move back with undoNullMove()
+         */
+        static UndoRecord executeNullMove(GameState &gameState)
+        {
+            const UndoRecord undoRecord{Figure::None,
+                                        gameState.board.enPassantTarget,
+                                        gameState.board.castlingRights,
+                                        gameState.gameStateHash,
+                                        gameState.halfMoveClock};
+
+            // remove en passant square from hash key if available, because the new move invalidates it
+            if (gameState.board.enPassantTarget != Square::undefined)
+            {
+                gameState.gameStateHash ^= ZobristHasher::enpassantKeys[gameState.board.enPassantTarget];
+            }
 
-                handlePawnPromotion(gameState, move, Figure::WhitePawn, Color::White, targetSquare);
+            // reset en-passant capture square, because opponent missed the chance in the last move
+            gameState.board.enPassantTarget = Square::undefined;
 
-                // handle en passant captures
-                if (move.isEnPassantCapture())
-                {
-                    // The en passant capture is always one behind a double pawn push from the opponent
-                    const Square actualPawnSquare = BitBoardOperations::getSouthSquareFromGivenSquare(targetSquare);
-                    removeFromBitboards(gameState, Figure::BlackPawn, Color::Black, actualPawnSquare);
-                }
+            // switch the side, literally giving opponent an extra move to make
+            gameState.board.sideToMove = Color(!bool(gameState.board.sideToMove));
+            gameState.gameStateHash ^= ZobristHasher::sideKey;
 
-                // remove en passant square from hash key if available, because the new move invalidates it
-                if (gameState.board.enPassantTarget != Square::undefined)
-                {
-                    gameState.gameStateHash ^= ZobristHasher::enpassantKeys[gameState.board.enPassantTarget];
-                }
+            return undoRecord;
+        }
 
-                // reset en passant square, because the new move invalidates it
-                gameState.board.enPassantTarget = Square::undefined;
+        static void undoNullMove(GameState &gameState, const UndoRecord &undoRecord)
+        {
+            gameState.board.enPassantTarget = undoRecord.enPassantTarget;
+            gameState.board.sideToMove = Color(!bool(gameState.board.sideToMove));
+            gameState.gameStateHash = undoRecord.gameStateHash;
+        }
 
-                // handle double pawn push
-                if (move.isDoublePawnPush())
-                {
-                    const Square enPassantTarget = BitBoardOperations::getSouthSquareFromGivenSquare(targetSquare);
-                    gameState.board.enPassantTarget = enPassantTarget;
-                    gameState.gameStateHash ^= ZobristHasher::enpassantKeys[enPassantTarget];
-                }
+        static bool executeMoveForWhite(GameState &gameState, Move move, MoveType moveType)
+        {
+            UndoRecord undoRecord;
 
-                // handle castling moves
-                if (castling)
-                {
-                    switch (targetSquare)
-                    {
-                        case (Square::g1):
-                            // white castles king side --> move H rook
-                            removeFromBitboards(gameState, Figure::WhiteRook, Color::White, Square::h1);
-                            addToBitboards(gameState, Figure::WhiteRook, Color::White, Square::f1);
-                            break;
-
-                        case (Square::c1):
-                            // white castles queen side --> move A rook
-                            removeFromBitboards(gameState, Figure::WhiteRook, Color::White, Square::a1);
-                            addToBitboards(gameState, Figure::WhiteRook, Color::White, Square::d1);
-                            break;
-                        default:
-                            // TODO throw exception
-                            break;
-                    }
-                }
+            return executeMoveWithLegalityCheck<Color::White>(gameState, move, moveType, undoRecord);
+        }
+
+        static bool executeMoveForBlack(GameState &gameState, Move move, MoveType moveType)
+        {
+            UndoRecord undoRecord;
+
+            return executeMoveWithLegalityCheck<Color::Black>(gameState, move, moveType, undoRecord);
+        }
+    private:
+        template<Color color>
+        static bool executeMoveWithLegalityCheck(GameState &gameState, Move move, MoveType moveType, UndoRecord &undoRecord)
+        {
+            // make quiet or capture move
+            if (moveType == MoveType::AllMoves or move.isCapture())
+            {
+                undoRecord = makeMove<color>(gameState, move);
 
                 // make sure that king has not been exposed into a check
-                if (const Square kingsSquare = BitBoardOperations::bitScanForward(gameState.board.bitboards[Figure::WhiteKing]);
-                        AttackQueries::squareIsAttackedByBlack(gameState.board, kingsSquare))
+                constexpr Figure king = (color == Color::White) ? Figure::WhiteKing : Figure::BlackKing;
+                constexpr Color opponentsColor = (color == Color::White) ? Color::Black : Color::White;
+
+                if (const Square kingsSquare = BitBoardOperations::bitScanForward(gameState.board.bitboards[king]);
+                        AttackQueries::squareIsAttacked<opponentsColor>(gameState.board, kingsSquare,
+                                                                        gameState.board.occupancies[Color::Both]))
                 {
                     // take move back
-                    gameState = gameStateCopy;
+                    unmakeMove<color>(gameState, move, undoRecord);
 
                     // return illegal move
                     return false;
                 }
 
-                // Remove old castling hash
-                gameState.gameStateHash ^= ZobristHasher::castleKeys[gameState.board.castlingRights];
-
-                // update castling rights
-                gameState.board.castlingRights = updateCastlingRights(gameState.board.castlingRights, sourceSquare, targetSquare);
-                gameState.gameStateHash ^= ZobristHasher::castleKeys[gameState.board.castlingRights]; // new castling hash
-
-                // change side to move
-                gameState.board.sideToMove = Color::Black;
-                gameState.gameStateHash ^= ZobristHasher::sideKey;
-                ++gameState.halfMoveClock;
-
                 // return legal move
                 return true;
             }
@@ -132,124 +173,182 @@ namespace ModernChess
             return false;
         }
 
-        static bool executeMoveForBlack(GameState &gameState, Move move, MoveType moveType)
+        template<Color color>
+        static UndoRecord makeMove(GameState &gameState, Move move)
         {
-            // make quiet or capture move
-            if (moveType == MoveType::AllMoves or move.isCapture())
+            constexpr Color opponentsColor = (color == Color::White) ? Color::Black : Color::White;
+            constexpr Figure pawn = (color == Color::White) ? Figure::WhitePawn : Figure::BlackPawn;
+            constexpr Figure rook = (color == Color::White) ? Figure::WhiteRook : Figure::BlackRook;
+            constexpr Figure opponentsPawn = (color == Color::White) ? Figure::BlackPawn : Figure::WhitePawn;
+
+            // The square behind the target square from the view of the moving side
+            constexpr auto squareBehind = [](Square square) {
+                return (color == Color::White) ? BitBoardOperations::getSouthSquareFromGivenSquare(square) :
+                                                 BitBoardOperations::getNorthSquareFromGivenSquare(square);
+            };
+
+            // parse move
+            const Square sourceSquare = move.getFrom();
+            const Square targetSquare = move.getTo();
+            const Figure movedFigure = move.getMovedFigure();
+
+            UndoRecord undoRecord{Figure::None,
+                                  gameState.board.enPassantTarget,
+                                  gameState.board.castlingRights,
+                                  gameState.gameStateHash,
+                                  gameState.halfMoveClock};
+
+            // handling capture moves. En passant captures are handled separately.
+            if (move.isCapture() and not move.isEnPassantCapture())
             {
-                // preserve board state
-                const GameState gameStateCopy = gameState;
+                undoRecord.capturedFigure = removeCapturedFigure(gameState, opponentsColor, targetSquare);
+            }
 
-                // parse move
-                const Square sourceSquare = move.getFrom();
-                const Square targetSquare = move.getTo();
-                const Figure movedFigure = move.getMovedFigure();
-                const bool castling = move.isCastlingMove();
+            // Add the moved figure into bitboards after the potential capture has been removed, otherwise we
+            // would potentially remove the moved figure again, if we go the other way around
+            removeFromBitboards(gameState, movedFigure, color, sourceSquare);
+            addToBitboards(gameState, movedFigure, color, targetSquare);
 
-                // handling capture moves
-                if (move.isCapture())
-                {
-                    removeCapturedFigure(gameState, Figure::WhitePawn, Figure::WhiteKing, Color::White, targetSquare);
-                }
+            handlePawnPromotion(gameState, move, pawn, color, targetSquare);
 
-                // Add the moved figure into bitboards after the potential capture has been removed, otherwise we
-                // would potentially remove the moved figure again, if we go the other way around
-                removeFromBitboards(gameState, movedFigure, Color::Black, sourceSquare);
-                addToBitboards(gameState, movedFigure, Color::Black, targetSquare);
+            // handle en passant captures
+            if (move.isEnPassantCapture())
+            {
+                // The en passant capture is always one behind a double pawn push from the opponent
+                removeFromBitboards(gameState, opponentsPawn, opponentsColor, squareBehind(targetSquare));
+            }
 
-                handlePawnPromotion(gameState, move, Figure::BlackPawn, Color::Black, targetSquare);
+            // remove en passant square from hash key if available, because the new move invalidates it
+            if (gameState.board.enPassantTarget != Square::undefined)
+            {
+                gameState.gameStateHash ^= ZobristHasher::enpassantKeys[gameState.board.enPassantTarget];
+            }
 
-                // handle en passant captures
-                if (move.isEnPassantCapture())
-                {
-                    // The en passant capture is always one behind a double pawn push from the opponent
-                    const Square actualPawnSquare = BitBoardOperations::getNorthSquareFromGivenSquare(targetSquare);
-                    removeFromBitboards(gameState, Figure::WhitePawn, Color::White, actualPawnSquare);
-                }
+            // reset en passant square, because the new move invalidates it
+            gameState.board.enPassantTarget = Square::undefined;
+
+            // handle double pawn push
+            if (move.isDoublePawnPush())
+            {
+                const Square enPassantTarget = squareBehind(targetSquare);
+                gameState.board.enPassantTarget = enPassantTarget;
+                gameState.gameStateHash ^= ZobristHasher::enpassantKeys[enPassantTarget];
+            }
 
-                // remove en passant square from hash key if available, because the new move invalidates it
-                if (gameState.board.enPassantTarget != Square::undefined)
+            // handle castling moves
+            if (move.isCastlingMove())
+            {
+                switch (targetSquare)
                 {
-                    gameState.gameStateHash ^= ZobristHasher::enpassantKeys[gameState.board.enPassantTarget];
+                    case (Square::g1):
+                    case (Square::g8):
+                        // castles king side --> move H rook
+                        removeFromBitboards(gameState, rook, color, Square(targetSquare + 1));
+                        addToBitboards(gameState, rook, color, Square(targetSquare - 1));
+                        break;
+
+                    case (Square::c1):
+                    case (Square::c8):
+                        // castles queen side --> move A rook
+                        removeFromBitboards(gameState, rook, color, Square(targetSquare - 2));
+                        addToBitboards(gameState, rook, color, Square(targetSquare + 1));
+                        break;
+                    default:
+                        // TODO throw exception
+                        break;
                 }
+            }
 
-                // reset en passant square
-                gameState.board.enPassantTarget = Square::undefined;
+            // Remove old castling hash
+            gameState.gameStateHash ^= ZobristHasher::castleKeys[gameState.board.castlingRights];
 
-                // handle double pawn push
-                if (move.isDoublePawnPush())
-                {
-                    const Square enPassantTarget = BitBoardOperations::getNorthSquareFromGivenSquare(targetSquare);
-                    gameState.board.enPassantTarget = enPassantTarget;
-                    gameState.gameStateHash ^= ZobristHasher::enpassantKeys[enPassantTarget];
-                }
+            // update castling rights
+            gameState.board.castlingRights = updateCastlingRights(gameState.board.castlingRights, sourceSquare, targetSquare);
+            gameState.gameStateHash ^= ZobristHasher::castleKeys[gameState.board.castlingRights]; // new castling hash
 
-                // handle castling moves
-                if (castling)
-                {
-                    switch (targetSquare)
-                    {
-                        case (Square::g8):
-                            // white castles king side --> move H rook
-                            removeFromBitboards(gameState, Figure::BlackRook, Color::Black, Square::h8);
-                            addToBitboards(gameState, Figure::BlackRook, Color::Black, Square::f8);
-                            break;
-
-                        case (Square::c8):
-                            // white castles queen side --> move A rook
-                            removeFromBitboards(gameState, Figure::BlackRook, Color::Black, Square::a8);
-                            addToBitboards(gameState, Figure::BlackRook, Color::Black, Square::d8);
-                            break;
-                        default:
-                            // TODO throw exception
-                            break;
-                    }
-                }
+            // change side to move
+            gameState.board.sideToMove = opponentsColor;
+            gameState.gameStateHash ^= ZobristHasher::sideKey;
 
-                // make sure that king has not been exposed into a check
-                if (const Square kingsSquare = BitBoardOperations::bitScanForward(gameState.board.bitboards[Figure::BlackKing]);
-                        AttackQueries::squareIsAttackedByWhite(gameState.board, kingsSquare))
-                {
-                    // take move back
-                    gameState = gameStateCopy;
+            // captures and pawn moves reset the fifty-move rule
+            if (move.isCapture() or movedFigure == pawn)
+            {
+                gameState.halfMoveClock = 0;
+            }
+            else
+            {
+                ++gameState.halfMoveClock;
+            }
 
-                    // return illegal move
-                    return false;
-                }
+            return undoRecord;
+        }
 
-                // Remove old castling hash
-                gameState.gameStateHash ^= ZobristHasher::castleKeys[gameState.board.castlingRights];
+        /**
+         * @brief Reverts makeMove(). The hash isn't updated incrementally, but restored from the undo record.
+         */
+        template<Color color>
+        static void unmakeMove(GameState &gameState, Move move, const UndoRecord &undoRecord)
+        {
+            constexpr Color opponentsColor = (color == Color::White) ? Color::Black : Color::White;
+            constexpr Figure rook = (color == Color::White) ? Figure::WhiteRook : Figure::BlackRook;
+            constexpr Figure opponentsPawn = (color == Color::White) ? Figure::BlackPawn : Figure::WhitePawn;
 
-                // update castling rights
-                gameState.board.castlingRights = updateCastlingRights(gameState.board.castlingRights, sourceSquare, targetSquare);
-                gameState.gameStateHash ^= ZobristHasher::castleKeys[gameState.board.castlingRights]; // new castling hash
+            const Square sourceSquare = move.getFrom();
+            const Square targetSquare = move.getTo();
+            const Figure movedFigure = move.getMovedFigure();
+            const Figure promotedPiece = move.getPromotedPiece();
 
-                // change side to move
-                gameState.board.sideToMove = Color::White;
-                gameState.gameStateHash ^= ZobristHasher::sideKey;
-                ++gameState.halfMoveClock;
+            Board &board = gameState.board;
 
-                // return legal move
-                return true;
+            // move the figure back and replace a promoted piece with the pawn
+            removeFigure(board, (promotedPiece != Figure::None) ? promotedPiece : movedFigure, color, targetSquare);
+            addFigure(board, movedFigure, color, sourceSquare);
+
+            if (undoRecord.capturedFigure != Figure::None)
+            {
+                addFigure(board, undoRecord.capturedFigure, opponentsColor, targetSquare);
             }
 
-            // Neither MoveType::AllMoves nor capture move --> won't be executed
-            return false;
-        }
-    private:
-        static void removeCapturedFigure(GameState &gameState, Figure bitBoardStart, Figure bitBoardEnd, Color opponentsColor, Square targetSquare)
-        {
-            // loop over bitboards opposite to the current side to move
-            for (Figure figure = bitBoardStart; figure <= bitBoardEnd; ++figure)
+            if (move.isEnPassantCapture())
+            {
+                const Square capturedPawnSquare = (color == Color::White) ?
+                                                  BitBoardOperations::getSouthSquareFromGivenSquare(targetSquare) :
+                                                  BitBoardOperations::getNorthSquareFromGivenSquare(targetSquare);
+                addFigure(board, opponentsPawn, opponentsColor, capturedPawnSquare);
+            }
+
+            if (move.isCastlingMove())
             {
-                // if there's a figure on the target square
-                if (BitBoardOperations::isOccupied(gameState.board.bitboards[figure], targetSquare))
+                if (targetSquare == Square::g1 or targetSquare == Square::g8)
                 {
-                    // remove it from opponents bitboard
-                    removeFromBitboards(gameState, figure, opponentsColor, targetSquare);
-                    break;
+                    removeFigure(board, rook, color, Square(targetSquare - 1));
+                    addFigure(board, rook, color, Square(targetSquare + 1));
+                }
+                else
+                {
+                    removeFigure(board, rook, color, Square(targetSquare + 1));
+                    addFigure(board, rook, color, Square(targetSquare - 2));
                 }
             }
+
+            board.enPassantTarget = undoRecord.enPassantTarget;
+            board.castlingRights = undoRecord.castlingRights;
+            board.sideToMove = color;
+            gameState.gameStateHash = undoRecord.gameStateHash;
+            gameState.halfMoveClock = undoRecord.halfMoveClock;
+        }
+
+        /**
+         * @return The captured figure
+         */
+        static Figure removeCapturedFigure(GameState &gameState, Color opponentsColor, Square targetSquare)
+        {
+            const Figure capturedFigure = gameState.board.mailbox[targetSquare];
+
+            // remove it from opponents bitboard
+            removeFromBitboards(gameState, capturedFigure, opponentsColor, targetSquare);
+
+            return capturedFigure;
         }
 
         static void handlePawnPromotion(GameState &gameState, Move move, Figure pawn, Color color, Square targetSquare)
@@ -266,9 +365,7 @@ namespace ModernChess
 
         static void removeFromBitboards(GameState &gameState, Figure figure, Color color, Square square)
         {
-            gameState.board.bitboards[figure] = BitBoardOperations::eraseSquare(gameState.board.bitboards[figure], square);
-            gameState.board.occupancies[color] = BitBoardOperations::eraseSquare(gameState.board.occupancies[color], square);
-            gameState.board.occupancies[Color::Both] = BitBoardOperations::eraseSquare(gameState.board.occupancies[Color::Both], square);
+            removeFigure(gameState.board, figure, color, square);
 
             // remove the figure from hash key
             gameState.gameStateHash ^= ZobristHasher::pieceKeys[figure][square];
@@ -276,12 +373,26 @@ namespace ModernChess
 
         static void addToBitboards(GameState &gameState, Figure figure, Color color, Square square)
         {
-            gameState.board.bitboards[figure] = BitBoardOperations::occupySquare(gameState.board.bitboards[figure], square);
-            gameState.board.occupancies[color] = BitBoardOperations::occupySquare(gameState.board.occupancies[color], square);
-            gameState.board.occupancies[Color::Both] = BitBoardOperations::occupySquare(gameState.board.occupancies[Color::Both], square);
+            addFigure(gameState.board, figure, color, square);
 
             // set figure to the target square in hash key
             gameState.gameStateHash ^= ZobristHasher::pieceKeys[figure][square];
         }
+
+        static void removeFigure(Board &board, Figure figure, Color color, Square square)
+        {
+            board.bitboards[figure] = BitBoardOperations::eraseSquare(board.bitboards[figure], square);
+            board.occupancies[color] = BitBoardOperations::eraseSquare(board.occupancies[color], square);
+            board.occupancies[Color::Both] = BitBoardOperations::eraseSquare(board.occupancies[Color::Both], square);
+            board.mailbox[square] = Figure::None;
+        }
+
+        static void addFigure(Board &board, Figure figure, Color color, Square square)
+        {
+            board.bitboards[figure] = BitBoardOperations::occupySquare(board.bitboards[figure], square);
+            board.occupancies[color] = BitBoardOperations::occupySquare(board.occupancies[color], square);
+            board.occupancies[Color::Both] = BitBoardOperations::occupySquare(board.occupancies[Color::Both], square);
+            board.mailbox[square] = figure;
+        }
     };
 }
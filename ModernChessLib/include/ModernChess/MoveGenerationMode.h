@@ -0,0 +1,25 @@
+#pragma once
+
+namespace ModernChess
+{
+    enum class MoveGenerationMode
+    {
+        PseudoLegal, ///< Moves which leave the king in check are rejected after the move has been made
+        Legal        ///< Only legal moves are generated
+    };
+
+    /**
+     * @brief Restricts the move generation to a subset of the moves. Captures, Promotions and QuietMoves
+     *        are disjoint and make up AllMoves together.
+     *        Evasions are only supported by the pseudo move generation, because the legal move generation
+     *        generates only evasions anyway, if the king is in check.
+     */
+    enum class MoveCategory
+    {
+        AllMoves,
+        Captures,   ///< All captures including capturing promotions and en passant captures
+        Promotions, ///< Promotions, which are not captures
+        QuietMoves, ///< Moves, which are neither captures nor promotions
+        Evasions    ///< King moves, captures of the checker and interpositions. The king has to be in check.
+    };
+}
@@ -0,0 +1,103 @@
+#pragma once
+
+#include "GlobalConstants.h"
+#include "Move.h"
+
+#include <array>
+#include <cassert>
+#include <utility>
+
+namespace ModernChess
+{
+    /**
+     * @brief Move with an inline score, which is used for move ordering
+     */
+    struct ScoredMove
+    {
+        Move move{};
+        int32_t score{};
+
+        // This makes it possible to iterate over a MoveList with Move as loop variable
+        operator Move() const { return move; }
+    };
+
+    /**
+     * @brief Move list with a fixed capacity, which lives on the stack.
+     *        In contrast to std::vector<Move> it doesn't allocate any memory on the heap.
+     */
+    class MoveList
+    {
+    public:
+        using Iterator = ScoredMove*;
+        using ConstIterator = const ScoredMove*;
+
+        template<typename... Args>
+        void emplace_back(Args &&... args)
+        {
+            assert(m_size < MaxNumberOfMoves);
+            m_moves[m_size++] = ScoredMove{Move(std::forward<Args>(args)...), 0};
+        }
+
+        void push_back(Move move)
+        {
+            assert(m_size < MaxNumberOfMoves);
+            m_moves[m_size++] = ScoredMove{move, 0};
+        }
+
+        void clear() { m_size = 0; }
+
+        [[nodiscard]] size_t size() const { return m_size; }
+
+        [[nodiscard]] bool empty() const { return m_size == 0; }
+
+        [[nodiscard]] ScoredMove &operator[](size_t index) { return m_moves[index]; }
+
+        [[nodiscard]] const ScoredMove &operator[](size_t index) const { return m_moves[index]; }
+
+        [[nodiscard]] Iterator begin() { return m_moves.data(); }
+
+        [[nodiscard]] Iterator end() { return m_moves.data() + m_size; }
+
+        [[nodiscard]] ConstIterator begin() const { return m_moves.data(); }
+
+        [[nodiscard]] ConstIterator end() const { return m_moves.data() + m_size; }
+
+        [[nodiscard]] bool contains(Move move) const
+        {
+            for (const Move currentMove : *this)
+            {
+                if (currentMove == move)
+                {
+                    return true;
+                }
+            }
+            return false;
+        }
+
+        /**
+         * @brief Sorts the moves by descending score. The sort is stable, i.e. moves with the same score keep
+         *        their generation order.
+         * @note Uses insertion sort, because std::stable_sort allocates a temporary buffer on the heap
+         *       and the move list is short anyway.
+         */
+        void sortByScore()
+        {
+            for (size_t i = 1; i < m_size; ++i)
+            {
+                const ScoredMove scoredMove = m_moves[i];
+                size_t j = i;
+
+                for (; j > 0 && m_moves[j - 1].score < scoredMove.score; --j)
+                {
+                    m_moves[j] = m_moves[j - 1];
+                }
+
+                m_moves[j] = scoredMove;
+            }
+        }
+
+    private:
+        std::array<ScoredMove, MaxNumberOfMoves> m_moves;
+        size_t m_size = 0;
+    };
+}
@@ -0,0 +1,168 @@
+#pragma once
+
+#include "GameState.h"
+#include "LegalMoveGeneration.h"
+#include "MoveGenerationMode.h"
+#include "MoveList.h"
+#include "PseudoMoveGeneration.h"
+#include "StaticExchangeEvaluation.h"
+
+#include <array>
+#include <optional>
+
+namespace ModernChess
+{
+    /**
+     * @brief Yields the moves of a position one by one in the order, in which they should be searched.
+     *        Moves are generated lazily in stages, so a beta cutoff by the hash move doesn't need any move generation
+     *        at all and a cutoff by a capture doesn't need the generation of quiet moves:
+     *        1. hash move
+     *        2. captures, which don't lose material, sorted by MVV-LVA, followed by promotions and
+     *           losing captures sorted by static exchange evaluation
+     *        3. killer moves
+     *        4. quiet moves, sorted by history score
+     *        If the king is in check, only evasions are generated and killer moves are not tried.
+     *        The quiescence search doesn't get any losing captures.
+     * @see https://www.chessprogramming.org/Move_Ordering#Staged_Move_Generation
+     */
+    class MovePicker
+    {
+    public:
+        static constexpr size_t MaxNumberOfKillerMoves = 2;
+
+        // killer moves of a ply [id]
+        using KillerMoves = std::array<Move, MaxNumberOfKillerMoves>;
+        // history moves [figure][square]
+        using HistoryMoves = std::array<std::array<int32_t, NumberOfSquares>, NumberOfFigureTypes>;
+
+        /**
+         * @brief Picks all moves for the main search
+         */
+        MovePicker(const GameState &gameState,
+                   MoveGenerationMode moveGenerationMode,
+                   Move hashMove,
+                   const KillerMoves &killerMoves,
+                   const HistoryMoves &historyMoves,
+                   bool kingIsInCheck);
+
+        /**
+         * @brief Picks only captures, which don't lose material, for the quiescence search
+         */
+        MovePicker(const GameState &gameState, MoveGenerationMode moveGenerationMode, Move hashMove);
+
+        /**
+         * @return the next move or a null move, if there are no moves left
+         */
+        [[nodiscard]] Move nextMove();
+
+        /**
+         * @return true, if the given hash move is a valid move of the current position
+         */
+        [[nodiscard]] bool hasHashMove() const
+        {
+            return not m_hashMove.isNullMove();
+        }
+
+    private:
+        enum class Stage : uint8_t
+        {
+            HashMove,
+            GenerateEvasions,
+            GenerateCaptures,
+            Captures,
+            Killers,
+            GenerateQuiets,
+            Quiets,
+            Done
+        };
+
+        /*
+         * @see https://www.chessprogramming.org/MVV-LVA
+         *
+         *   (Victims) Pawn Knight Bishop   Rook  Queen   King
+         *
+         * (Attackers)
+         *       Pawn   105    205    305    405    505    605
+         *     Knight   104    204    304    404    504    604
+         *     Bishop   103    203    303    403    503    603
+         *       Rook   102    202    302    402    502    602
+         *      Queen   101    201    301    401    501    601
+         *       King   100    200    300    400    500    600
+         */
+
+        // most valuable victim & less valuable attacker [attacker][victim]
+        static constexpr std::array<std::array<int32_t, NumberOfFigureTypes>, NumberOfFigureTypes> mvvLva {
+            {
+                {105, 205, 305, 405, 505, 605,  105, 205, 305, 405, 505, 605},
+                {104, 204, 304, 404, 504, 604,  104, 204, 304, 404, 504, 604},
+                {103, 203, 303, 403, 503, 603,  103, 203, 303, 403, 503, 603},
+                {102, 202, 302, 402, 502, 602,  102, 202, 302, 402, 502, 602},
+                {101, 201, 301, 401, 501, 601,  101, 201, 301, 401, 501, 601},
+                {100, 200, 300, 400, 500, 600,  100, 200, 300, 400, 500, 600},
+
+                {105, 205, 305, 405, 505, 605,  105, 205, 305, 405, 505, 605},
+                {104, 204, 304, 404, 504, 604,  104, 204, 304, 404, 504, 604},
+                {103, 203, 303, 403, 503, 603,  103, 203, 303, 403, 503, 603},
+                {102, 202, 302, 402, 502, 602,  102, 202, 302, 402, 502, 602},
+                {101, 201, 301, 401, 501, 601,  101, 201, 301, 401, 501, 601},
+                {100, 200, 300, 400, 500, 600,  100, 200, 300, 400, 500, 600}
+            }
+        };
+
+        const GameState &m_gameState;
+        const MoveGenerationMode m_moveGenerationMode;
+        const KillerMoves m_killerMoves{};
+        const HistoryMoves *m_historyMoves = nullptr;
+        const bool m_capturesOnly;
+        const bool m_evasionsOnly = false;
+
+        Stage m_stage = Stage::HashMove;
+        Move m_hashMove{};
+        size_t m_currentIndex = 0;
+        // Captures and promotions or capturing evasions are followed by the quiet moves. A single list keeps
+        // the stack of a deep search small, because every ply holds a move picker.
+        MoveList m_moves;
+        // end of the captures and begin of the quiet moves
+        size_t m_capturesEnd = 0;
+        // Is computed only on demand, i.e. if a hash or killer move has to be verified
+        std::optional<CheckInfo> m_checkInfo{};
+
+        /**
+         * @brief Verifies moves, which are not coming from the move generation of the current position
+         */
+        [[nodiscard]] bool isValid(Move move);
+
+        template<MoveCategory category>
+        void generateMoves(MoveList &moves) const
+        {
+            if (m_moveGenerationMode == MoveGenerationMode::Legal)
+            {
+                LegalMoveGeneration::generateMoves<category>(m_gameState, moves);
+            }
+            else
+            {
+                PseudoMoveGeneration::generateMoves<category>(m_gameState, moves);
+            }
+        }
+
+        void generateEvasions();
+
+        void generateCaptures();
+
+        void scoreCaptures();
+
+        void scoreQuietMoves();
+
+        void generateQuietMoves();
+
+        [[nodiscard]] bool isKillerMove(Move move) const;
+
+        /**
+         * @brief Selects the best scored move of the remaining moves. A full sort is not necessary, because
+         *        most of the time a beta cutoff happens after the first few moves.
+         */
+        [[nodiscard]] static Move pickBestMove(MoveList &moves, size_t currentIndex, size_t endIndex);
+
+        [[nodiscard]] Figure getCapturedFigure(Move move) const;
+    };
+}
@@ -0,0 +1,86 @@
+#pragma once
+
+#include "GameState.h"
+#include "Move.h"
+#include "MoveExecution.h"
+#include "MoveGenerationMode.h"
+#include "StopSignal.h"
+
+#include <cinttypes>
+#include <functional>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace ModernChess
+{
+    /**
+     * @brief Counts the leaf nodes of the move generation tree up to a given depth.
+     *        It is used for validating and benchmarking the move generation.
+     * @see https://www.chessprogramming.org/Perft
+     */
+    class Perft
+    {
+    public:
+        // Number of leaf nodes for every root move
+        using DivideResult = std::vector<std::pair<Move, uint64_t>>;
+
+        /**
+         * @param hashTableSizeInMb Node counts of transpositions are stored in a hash table. 0 disables the table.
+         * @param numberOfThreads Root moves are distributed on this number of threads
+         * @param moveGenerationMode In legal mode, the moves of the last ply are counted without making them
+         * @param moveUndoMode Copy-make is kept for comparing it with make-unmake in benchmarks
+         */
+        explicit Perft(size_t hashTableSizeInMb = 0,
+                       size_t numberOfThreads = 1,
+                       MoveGenerationMode moveGenerationMode = MoveGenerationMode::Legal,
+                       MoveUndoMode moveUndoMode = MoveUndoMode::MakeUnmake);
+
+        [[nodiscard]] uint64_t countNodes(const GameState &gameState, uint32_t depth);
+
+        [[nodiscard]] DivideResult divide(const GameState &gameState, uint32_t depth);
+
+        /**
+         * @brief Can be stopped by another thread, e.g. by a stop command of the UI
+         * @return Incomplete node counts, if the stop signal has been set
+         */
+        [[nodiscard]] DivideResult divide(const GameState &gameState, uint32_t depth, const StopSignal &stopSignal);
+
+    private:
+        /**
+         * @brief The key is XORed with the data, so entries can be shared between threads without locks.
+         *        A torn entry, written concurrently by two threads, doesn't match the hash anymore.
+         * @see https://www.chessprogramming.org/Shared_Hash_Table#Lockless
+         */
+        struct HashEntry {
+            uint64_t key{};
+            // node count in the upper 56 bits, depth in the lower 8 bits
+            uint64_t data{};
+        };
+
+        static constexpr uint32_t MaxHashDepth = 0xFF;
+
+        size_t m_numberOfThreads;
+        MoveGenerationMode m_moveGenerationMode;
+        MoveUndoMode m_moveUndoMode;
+        std::unique_ptr<HashEntry[], std::function<void(HashEntry*)>> m_hashTable;
+        size_t m_numberHashEntries{};
+        const StopSignal *m_stopSignal = nullptr;
+
+        [[nodiscard]] bool isStopped() const
+        {
+            return m_stopSignal != nullptr and m_stopSignal->isStopped();
+        }
+
+        /**
+         * @return Legal root moves with the game state after the move
+         */
+        [[nodiscard]] std::vector<std::pair<Move, GameState>> generateRootMoves(const GameState &gameState) const;
+
+        [[nodiscard]] uint64_t countNodesRecursively(GameState &gameState, uint32_t depth);
+
+        [[nodiscard]] bool probe(uint64_t hash, uint32_t depth, uint64_t &numberOfNodes) const;
+
+        void store(uint64_t hash, uint32_t depth, uint64_t numberOfNodes);
+    };
+}
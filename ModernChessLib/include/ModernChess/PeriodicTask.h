@@ -60,11 +60,11 @@ namespace ModernChess
             while (continueTask)
             {
                 std::unique_lock lock(m_mutex);
-                m_triggered.waitFor(lock, m_period, [this, &continueTask]
+                m_triggered.waitFor(lock, m_period, [this]
                 {
-                    continueTask = not m_isStopped;
-                    return continueTask;
+                    return m_isStopped;
                 });
+                continueTask = not m_isStopped;
                 lock.unlock();
 
                 if (continueTask)
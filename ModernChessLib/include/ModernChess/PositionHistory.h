@@ -0,0 +1,107 @@
+#pragma once
+
+#include "Figure.h"
+#include "Move.h"
+
+#include <cinttypes>
+#include <vector>
+
+namespace ModernChess
+{
+    /**
+     * @brief Stack of the hashes of the positions of the game and of the currently searched moves.
+     *        A position can't occur again after an irreversible move, so a position is only compared with the
+     *        positions since the last irreversible move.
+     * @see https://www.chessprogramming.org/Repetitions
+     */
+    class PositionHistory
+    {
+    public:
+        PositionHistory()
+        {
+            m_positions.reserve(InitialCapacity);
+        }
+
+        /**
+         * @param isIrreversible The position has been reached by an irreversible move or it is the first
+         *                       known position of the game
+         */
+        void push(uint64_t hash, bool isIrreversible)
+        {
+            const uint32_t lastIrreversible = (isIrreversible or m_positions.empty()) ?
+                                              uint32_t(m_positions.size()) : m_positions.back().lastIrreversible;
+            m_positions.push_back(Position{hash, lastIrreversible});
+        }
+
+        void pop()
+        {
+            m_positions.pop_back();
+        }
+
+        void clear()
+        {
+            m_positions.clear();
+        }
+
+        [[nodiscard]] bool isEmpty() const
+        {
+            return m_positions.empty();
+        }
+
+        [[nodiscard]] uint64_t getCurrentHash() const
+        {
+            return m_positions.back().hash;
+        }
+
+        /**
+         * @return true, if the current position has already occurred. Only positions with the same side to move
+         *         are compared and a position can't repeat earlier than four half moves later.
+         */
+        [[nodiscard]] bool isRepetition() const
+        {
+            const auto current = int64_t(m_positions.size()) - 1;
+
+            if (current < 0)
+            {
+                return false;
+            }
+
+            const uint64_t hash = m_positions[current].hash;
+            const auto lastIrreversible = int64_t(m_positions[current].lastIrreversible);
+
+            for (int64_t index = current - 4; index >= lastIrreversible; index -= 2)
+            {
+                if (m_positions[index].hash == hash)
+                {
+                    return true;
+                }
+            }
+
+            return false;
+        }
+
+        /**
+         * @return true, if the positions before the move can't occur again
+         */
+        [[nodiscard]] static bool isIrreversible(Move move)
+        {
+            const Figure movedFigure = move.getMovedFigure();
+
+            return move.isCapture() or
+                   move.isCastlingMove() or
+                   movedFigure == Figure::WhitePawn or
+                   movedFigure == Figure::BlackPawn;
+        }
+
+    private:
+        static constexpr size_t InitialCapacity = 512;
+
+        struct Position {
+            uint64_t hash;
+            // index of the position after the last irreversible move
+            uint32_t lastIrreversible;
+        };
+
+        std::vector<Position> m_positions;
+    };
+}
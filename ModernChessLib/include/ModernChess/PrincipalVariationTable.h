@@ -32,11 +32,10 @@ namespace ModernChess
          * 5    0    0    0    0    0    m6
          */
 
-        explicit PrincipalVariationTable(int32_t rootHalfMoveClock) :
-                rootHalfMoveClock(rootHalfMoveClock) {}
-
-        std::array<std::array<Move, MaxHalfMoves>, MaxHalfMoves> pvTable{};
-        std::array<int32_t, MaxHalfMoves> pvLength{};
+        // [ply][ply], the PV of the root is in row 0
+        std::array<std::array<Move, MaxPly>, MaxPly> pvTable{};
+        // The length is also initialized by a node at max ply, which doesn't search any move
+        std::array<int32_t, MaxPly + 1> pvLength{};
 
         void addPrincipalVariation(const Move move, int32_t ply)
         {
@@ -57,21 +56,18 @@ namespace ModernChess
 
         [[nodiscard]] ConstIterator begin() const
         {
-            return &pvTable[rootHalfMoveClock][rootHalfMoveClock];
+            return &pvTable[0][0];
         }
 
         [[nodiscard]] ConstIterator end() const
         {
-            const size_t end = pvLength[rootHalfMoveClock];
-            return &pvTable[rootHalfMoveClock][end];
+            const size_t end = pvLength[0];
+            return &pvTable[0][end];
         }
 
         [[nodiscard]] size_t size() const
         {
-            return pvLength[rootHalfMoveClock];
+            return pvLength[0];
         }
-
-    private:
-        int32_t rootHalfMoveClock{};
     };
 }
\ No newline at end of file
@@ -3,10 +3,10 @@
 #include "AttackQueries.h"
 #include "GameState.h"
 #include "BitBoardOperations.h"
-#include "Move.h"
+#include "MoveGenerationMode.h"
+#include "MoveList.h"
 
-#include <vector>
-#include <functional>
+#include <cassert>
 
 namespace ModernChess
 {
@@ -18,301 +18,416 @@ namespace ModernChess
     public:
         PseudoMoveGeneration() = delete;
 
-        [[nodiscard]] static std::vector<Move> generateMoves(const GameState &gameState)
+        /**
+         * @tparam category e.g. only captures for the quiescence search
+         */
+        template<MoveCategory category = MoveCategory::AllMoves>
+        [[nodiscard]] static MoveList generateMoves(const GameState &gameState)
         {
-            std::vector<Move> movesToBeGenerated;
-            movesToBeGenerated.reserve(256);
+            MoveList movesToBeGenerated;
+            generateMoves<category>(gameState, movesToBeGenerated);
 
+            return movesToBeGenerated;
+        }
+
+        /**
+         * @brief Appends the generated moves to the given move list
+         */
+        template<MoveCategory category = MoveCategory::AllMoves>
+        static void generateMoves(const GameState &gameState, MoveList &movesToBeGenerated)
+        {
             if (gameState.board.sideToMove == Color::White)
             {
-                PseudoMoveGeneration::generateWhiteFigureMoves(gameState, movesToBeGenerated);
+                generateFigureMoves<Color::White, category>(gameState, movesToBeGenerated);
             }
             else
             {
-                PseudoMoveGeneration::generateBlackFigureMoves(gameState, movesToBeGenerated);
+                generateFigureMoves<Color::Black, category>(gameState, movesToBeGenerated);
             }
+        }
 
-            return movesToBeGenerated;
+        static void generateBlackFigureMoves(const GameState &gameState, MoveList &movesToBeGenerated)
+        {
+            generateFigureMoves<Color::Black>(gameState, movesToBeGenerated);
         }
 
-        static void generateBlackFigureMoves(const GameState &gameState, std::vector<Move> &movesToBeGenerated)
+        static void generateWhiteFigureMoves(const GameState &gameState, MoveList &movesToBeGenerated)
         {
-            generateBlackPawnMoves(gameState, movesToBeGenerated);
-            generateBlackKingMoves(gameState, movesToBeGenerated);
+            generateFigureMoves<Color::White>(gameState, movesToBeGenerated);
+        }
 
+        /**
+         * @brief Checks, whether the move would have been generated in the given position without generating
+         *        all moves. This is needed for moves, which stem from other positions, e.g. hash or killer moves.
+         */
+        [[nodiscard]] static bool isPseudoLegal(const GameState &gameState, Move move)
+        {
+            if (gameState.board.sideToMove == Color::White)
             {
-                // Black Knight Moves
-                std::function<BitBoardState(Square)> getAttacks = [&gameState](Square sourceSquare)
-                {
-                    return AttackQueries::knightAttackTable[sourceSquare] &
-                           (~gameState.board.occupancies[Color::Black]);
-                };
-
-                generatePieceMoves(gameState, movesToBeGenerated, Color::White, Figure::BlackKnight,
-                                   std::move(getAttacks));
+                return isPseudoLegal<Color::White>(gameState.board, move);
             }
-            {
-                // Black Bishop Moves
-                std::function<BitBoardState(Square)> getAttacks = [&gameState](Square sourceSquare)
-                {
-                    return AttackQueries::bishopAttacks.getAttacks(sourceSquare,
-                                                                   gameState.board.occupancies[Color::Both]) &
-                           (~gameState.board.occupancies[Color::Black]);
-                };
 
-                generatePieceMoves(gameState, movesToBeGenerated, Color::White, Figure::BlackBishop,
-                                   std::move(getAttacks));
-            }
-            {
-                // Black Rook Moves
-                std::function<BitBoardState(Square)> getAttacks = [&gameState](Square sourceSquare)
-                {
-                    return AttackQueries::rookAttacks.getAttacks(sourceSquare,
-                                                                 gameState.board.occupancies[Color::Both]) &
-                           (~gameState.board.occupancies[Color::Black]);
-                };
+            return isPseudoLegal<Color::Black>(gameState.board, move);
+        }
 
-                generatePieceMoves(gameState, movesToBeGenerated, Color::White, Figure::BlackRook,
-                                   std::move(getAttacks));
-            }
+    private:
+        // The legal move generation shares the building blocks of the pseudo move generation
+        friend class LegalMoveGeneration;
+
+        template<Color color>
+        static constexpr Color opponentOf()
+        {
+            return (color == Color::White) ? Color::Black : Color::White;
+        }
+
+        /**
+         * @param whiteFigure figure type given as white figure
+         * @return figure type of the given color
+         */
+        template<Color color>
+        static constexpr Figure figureOf(Figure whiteFigure)
+        {
+            return (color == Color::White) ? whiteFigure : Figure(whiteFigure + Figure::BlackPawn);
+        }
+
+        template<Color color, MoveCategory category = MoveCategory::AllMoves>
+        static void generateFigureMoves(const GameState &gameState, MoveList &movesToBeGenerated)
+        {
+            if constexpr (category == MoveCategory::Evasions)
             {
-                // Black Queen Moves
-                std::function<BitBoardState(Square)> getAttacks = [&gameState](Square sourceSquare)
-                {
-                    return AttackQueries::queenAttacks.getAttacks(sourceSquare,
-                                                                  gameState.board.occupancies[Color::Both]) &
-                           (~gameState.board.occupancies[Color::Black]);
-                };
+                generateEvasions<color>(gameState, movesToBeGenerated);
+                return;
+            }
+
+            generatePawnMoves<color, category>(gameState, movesToBeGenerated);
 
-                generatePieceMoves(gameState, movesToBeGenerated, Color::White, Figure::BlackQueen,
-                                   std::move(getAttacks));
+            // Only pawns are able to promote
+            if constexpr (category != MoveCategory::Promotions)
+            {
+                generateKingMoves<color, category>(gameState, movesToBeGenerated);
+                generatePieceMoves<color, figureOf<color>(Figure::WhiteKnight), category>(gameState, movesToBeGenerated);
+                generatePieceMoves<color, figureOf<color>(Figure::WhiteBishop), category>(gameState, movesToBeGenerated);
+                generatePieceMoves<color, figureOf<color>(Figure::WhiteRook), category>(gameState, movesToBeGenerated);
+                generatePieceMoves<color, figureOf<color>(Figure::WhiteQueen), category>(gameState, movesToBeGenerated);
             }
         }
 
-        static void generateWhiteFigureMoves(const GameState &gameState, std::vector<Move> &movesToBeGenerated)
+        /**
+         * @brief Generates only moves, which might resolve a check: king moves, captures of the checker and
+         *        interpositions on the squares between king and checker. In a double check only the king is able
+         *        to move. The moves are still pseudo legal, e.g. a king move might go to an attacked square
+         *        or an interposing figure might be pinned.
+         * @precondition king is in check
+         */
+        template<Color color>
+        static void generateEvasions(const GameState &gameState, MoveList &movesToBeGenerated)
         {
-            generateWhitePawnMoves(gameState, movesToBeGenerated);
-            generateWhiteKingMoves(gameState, movesToBeGenerated);
+            constexpr Figure king = figureOf<color>(Figure::WhiteKing);
+            const Board &board = gameState.board;
 
+            const Square kingSquare = BitBoardOperations::bitScanForward(board.bitboards[king]);
+            const BitBoardState checkers = AttackQueries::attackersOfSquare<opponentOf<color>()>(
+                    board, kingSquare, board.occupancies[Color::Both]);
+
+            assert(checkers != BoardState::empty);
+
+            // No double check
+            if ((checkers & (checkers - 1)) == BoardState::empty)
             {
-                // White Knight Moves
-                std::function<BitBoardState(Square)> getAttacks = [&gameState](Square sourceSquare)
-                {
-                    return AttackQueries::knightAttackTable[sourceSquare] &
-                           (~gameState.board.occupancies[Color::White]);
-                };
+                const Square checkerSquare = BitBoardOperations::bitScanForward(checkers);
+                const BitBoardState checkMask = checkers | AttackQueries::squaresBetween[kingSquare][checkerSquare];
+
+                generatePawnMoves<color, MoveCategory::AllMoves>(gameState, movesToBeGenerated, checkMask);
+                generatePieceMoves<color, figureOf<color>(Figure::WhiteKnight), MoveCategory::AllMoves>(gameState, movesToBeGenerated, checkMask);
+                generatePieceMoves<color, figureOf<color>(Figure::WhiteBishop), MoveCategory::AllMoves>(gameState, movesToBeGenerated, checkMask);
+                generatePieceMoves<color, figureOf<color>(Figure::WhiteRook), MoveCategory::AllMoves>(gameState, movesToBeGenerated, checkMask);
+                generatePieceMoves<color, figureOf<color>(Figure::WhiteQueen), MoveCategory::AllMoves>(gameState, movesToBeGenerated, checkMask);
+            }
+
+            // Castling is not allowed in check
+            generatePieceMoves<color, king, MoveCategory::AllMoves>(gameState, movesToBeGenerated);
+        }
 
-                generatePieceMoves(gameState, movesToBeGenerated, Color::Black, Figure::WhiteKnight,
-                                   std::move(getAttacks));
+        /**
+         * @return Target squares of non-pawn figures for the given move category
+         */
+        template<Color color, MoveCategory category>
+        [[nodiscard]] static BitBoardState getTargetMask(const Board &board)
+        {
+            static_assert(category != MoveCategory::Promotions, "Only pawns are able to promote");
+
+            if constexpr (category == MoveCategory::Captures)
+            {
+                return board.occupancies[opponentOf<color>()];
             }
+            else if constexpr (category == MoveCategory::QuietMoves)
             {
-                // White Bishop Moves
-                std::function<BitBoardState(Square)> getAttacks = [&gameState](Square sourceSquare)
-                {
-                    return AttackQueries::bishopAttacks.getAttacks(sourceSquare,
-                                                                   gameState.board.occupancies[Color::Both]) &
-                           (~gameState.board.occupancies[Color::White]);
-                };
-
-                generatePieceMoves(gameState, movesToBeGenerated, Color::Black, Figure::WhiteBishop,
-                                   std::move(getAttacks));
+                return ~board.occupancies[Color::Both];
             }
+            else
             {
-                // White Rook Moves
-                std::function<BitBoardState(Square)> getAttacks = [&gameState](Square sourceSquare)
-                {
-                    return AttackQueries::rookAttacks.getAttacks(sourceSquare,
-                                                                 gameState.board.occupancies[Color::Both]) &
-                           (~gameState.board.occupancies[Color::White]);
-                };
+                return ~board.occupancies[color];
+            }
+        }
 
-                generatePieceMoves(gameState, movesToBeGenerated, Color::Black, Figure::WhiteRook,
-                                   std::move(getAttacks));
+        /**
+         * @brief Attacks of a piece resolved at compile time, so the compiler can inline the lookup
+         *        for every piece kind.
+         */
+        template<Figure piece>
+        [[nodiscard]] static BitBoardState getPieceAttacks(Square sourceSquare, BitBoardState occupiedSquares)
+        {
+            if constexpr (piece == Figure::WhiteKnight || piece == Figure::BlackKnight)
+            {
+                return AttackQueries::knightAttackTable[sourceSquare];
             }
+            else if constexpr (piece == Figure::WhiteBishop || piece == Figure::BlackBishop)
             {
-                // White Queen Moves
-                std::function<BitBoardState(Square)> getAttacks = [&gameState](Square sourceSquare)
-                {
-                    return AttackQueries::queenAttacks.getAttacks(sourceSquare,
-                                                                  gameState.board.occupancies[Color::Both]) &
-                           (~gameState.board.occupancies[Color::White]);
-                };
-
-                generatePieceMoves(gameState, movesToBeGenerated, Color::Black, Figure::WhiteQueen,
-                                   std::move(getAttacks));
+                return AttackQueries::bishopAttacks.getAttacks(sourceSquare, occupiedSquares);
+            }
+            else if constexpr (piece == Figure::WhiteRook || piece == Figure::BlackRook)
+            {
+                return AttackQueries::rookAttacks.getAttacks(sourceSquare, occupiedSquares);
+            }
+            else if constexpr (piece == Figure::WhiteQueen || piece == Figure::BlackQueen)
+            {
+                return AttackQueries::queenAttacks.getAttacks(sourceSquare, occupiedSquares);
+            }
+            else
+            {
+                static_assert(piece == Figure::WhiteKing || piece == Figure::BlackKing, "Pawns are not supported");
+                return AttackQueries::kingAttackTable[sourceSquare];
             }
         }
 
-    private:
-        static void generateWhitePawnMoves(const GameState &gameState, std::vector<Move> &movesToBeGenerated)
+        /**
+         * @param checkMask restricts the target squares, e.g. for resolving a check
+         */
+        template<Color color, MoveCategory category>
+        static void generatePawnMoves(const GameState &gameState,
+                                      MoveList &movesToBeGenerated,
+                                      BitBoardState checkMask = BoardState::allSquaresOccupied)
         {
-            BitBoardState whitePawnBitboard = gameState.board.bitboards[Figure::WhitePawn];
+            constexpr bool generateCaptures = (category == MoveCategory::AllMoves || category == MoveCategory::Captures);
+            constexpr bool generatePromotions = (category == MoveCategory::AllMoves || category == MoveCategory::Promotions);
+            constexpr bool generatePushes = (category == MoveCategory::AllMoves || category == MoveCategory::QuietMoves);
+
+            constexpr Color opponentsColor = opponentOf<color>();
+            constexpr Figure pawn = figureOf<color>(Figure::WhitePawn);
+
+            // White pawns are moving towards north direction and black pawns towards south direction
+            constexpr auto pushSquare = [](Square square) {
+                return (color == Color::White) ? BitBoardOperations::getNorthSquareFromGivenSquare(square) :
+                                                 BitBoardOperations::getSouthSquareFromGivenSquare(square);
+            };
+
+            // Pawns on these ranks promote on their next move or are able to do a double pawn push
+            constexpr Square promotionRankStart = (color == Color::White) ? Square::a7 : Square::a2;
+            constexpr Square promotionRankEnd = (color == Color::White) ? Square::h7 : Square::h2;
+            constexpr Square doublePushRankStart = (color == Color::White) ? Square::a2 : Square::a7;
+            constexpr Square doublePushRankEnd = (color == Color::White) ? Square::h2 : Square::h7;
+
+            BitBoardState pawnBitboard = gameState.board.bitboards[pawn];
 
-            // loop over white pawns within white pawn bitboard
-            while (whitePawnBitboard != BoardState::empty)
+            if constexpr (category == MoveCategory::Promotions)
             {
-                const Square sourceSquare = BitBoardOperations::bitScanForward(whitePawnBitboard);
+                // Only pawns, which are one step before the promotion
+                pawnBitboard &= (color == Color::White) ? BitBoardConstants::rank7 : BitBoardConstants::rank2;
+            }
+
+            // loop over pawns within pawn bitboard
+            while (pawnBitboard != BoardState::empty)
+            {
+                const Square sourceSquare = BitBoardOperations::bitScanForward(pawnBitboard);
+                const bool isPromotion = (sourceSquare >= promotionRankStart && sourceSquare <= promotionRankEnd);
 
+                if (isPromotion ? generatePromotions : generatePushes)
                 {
-                    // White pawns are moving towards north direction
                     // generate quite pawn moves
-                    const Square targetSquare = BitBoardOperations::getNorthSquareFromGivenSquare(sourceSquare);
+                    const Square targetSquare = pushSquare(sourceSquare);
 
-                    if (const bool targetSquareIsOnBoard = (targetSquare <= Square::h8);
-                            targetSquareIsOnBoard &&
-                            !BitBoardOperations::isOccupied(gameState.board.occupancies[Color::Both], targetSquare))
+                    const bool targetSquareIsOnBoard = (color == Color::White) ? (targetSquare <= Square::h8) :
+                                                                                 (targetSquare >= Square::a1);
+
+                    if (targetSquareIsOnBoard &&
+                        !BitBoardOperations::isOccupied(gameState.board.occupancies[Color::Both], targetSquare))
                     {
                         // pawn promotion
-                        if (sourceSquare >= a7 && sourceSquare <= h7)
+                        if (isPromotion)
                         {
-                            movesToBeGenerated.emplace_back(sourceSquare, targetSquare, Figure::WhitePawn,
-                                                            Figure::WhiteQueen,
-                                                            false, false, false, false);
-                            movesToBeGenerated.emplace_back(sourceSquare, targetSquare, Figure::WhitePawn,
-                                                            Figure::WhiteRook,
-                                                            false, false, false, false);
-                            movesToBeGenerated.emplace_back(sourceSquare, targetSquare, Figure::WhitePawn,
-                                                            Figure::WhiteBishop,
-                                                            false, false, false, false);
-                            movesToBeGenerated.emplace_back(sourceSquare, targetSquare, Figure::WhitePawn,
-                                                            Figure::WhiteKnight,
-                                                            false, false, false, false);
+                            if (BitBoardOperations::isOccupied(checkMask, targetSquare))
+                            {
+                                addPromotions<color>(movesToBeGenerated, sourceSquare, targetSquare, false);
+                            }
                         }
                         else
                         {
                             // single pawn push
-                            movesToBeGenerated.emplace_back(sourceSquare, targetSquare, Figure::WhitePawn, Figure::None,
-                                                            false, false, false, false);
+                            if (BitBoardOperations::isOccupied(checkMask, targetSquare))
+                            {
+                                movesToBeGenerated.emplace_back(sourceSquare, targetSquare, pawn, Figure::None,
+                                                                false, false, false, false);
+                            }
 
-                            // double pawn push
-                            if ((sourceSquare >= a2 && sourceSquare <= h2) &&
+                            // double pawn push. It might block a check, even if the single push doesn't.
+                            if ((sourceSquare >= doublePushRankStart && sourceSquare <= doublePushRankEnd) &&
                                 !BitBoardOperations::isOccupied(gameState.board.occupancies[Color::Both],
-                                                                BitBoardOperations::getNorthSquareFromGivenSquare(
-                                                                        targetSquare)))
+                                                                pushSquare(targetSquare)) &&
+                                BitBoardOperations::isOccupied(checkMask, pushSquare(targetSquare)))
                             {
-                                movesToBeGenerated.emplace_back(sourceSquare,
-                                                                BitBoardOperations::getNorthSquareFromGivenSquare(
-                                                                        targetSquare), Figure::WhitePawn, Figure::None,
-                                                                false, true, false, false);
+                                movesToBeGenerated.emplace_back(sourceSquare, pushSquare(targetSquare), pawn,
+                                                                Figure::None, false, true, false, false);
                             }
                         }
                     }
                 }
 
-                // init pawn attacks of whitePawnBitboard and generate pawn captures
-                for (BitBoardState attacks = AttackQueries::pawnAttackTable[Color::White][sourceSquare] &
-                                             gameState.board.occupancies[Color::Black];
-                     attacks != BoardState::empty;
-                        )
+                if constexpr (generateCaptures)
                 {
-                    // init target square
-                    const Square targetSquare = BitBoardOperations::bitScanForward(attacks);
-
-                    // pawn promotion
-                    if (sourceSquare >= a7 && sourceSquare <= h7)
-                    {
-                        movesToBeGenerated.emplace_back(sourceSquare, targetSquare, Figure::WhitePawn,
-                                                        Figure::WhiteQueen,
-                                                        true, false, false, false);
-                        movesToBeGenerated.emplace_back(sourceSquare, targetSquare, Figure::WhitePawn,
-                                                        Figure::WhiteRook,
-                                                        true, false, false, false);
-                        movesToBeGenerated.emplace_back(sourceSquare, targetSquare, Figure::WhitePawn,
-                                                        Figure::WhiteBishop,
-                                                        true, false, false, false);
-                        movesToBeGenerated.emplace_back(sourceSquare, targetSquare, Figure::WhitePawn,
-                                                        Figure::WhiteKnight,
-                                                        true, false, false, false);
-                    }
-                    else
+                    // init pawn attacks of pawnBitboard and generate pawn captures
+                    for (BitBoardState attacks = AttackQueries::pawnAttackTable[color][sourceSquare] &
+                                                 gameState.board.occupancies[opponentsColor] & checkMask;
+                         attacks != BoardState::empty;
+                            )
                     {
-                        // one square ahead pawn move
-                        movesToBeGenerated.emplace_back(sourceSquare, targetSquare, Figure::WhitePawn, Figure::None,
-                                                        true,
-                                                        false, false, false);
-                    }
+                        // init target square
+                        const Square targetSquare = BitBoardOperations::bitScanForward(attacks);
 
-                    attacks = BitBoardOperations::eraseSquare(attacks, targetSquare);
-                }
+                        // pawn promotion
+                        if (isPromotion)
+                        {
+                            addPromotions<color>(movesToBeGenerated, sourceSquare, targetSquare, true);
+                        }
+                        else
+                        {
+                            // one square ahead pawn move
+                            movesToBeGenerated.emplace_back(sourceSquare, targetSquare, pawn, Figure::None,
+                                                            true, false, false, false);
+                        }
 
-                // generate en passant captures
-                if (gameState.board.enPassantTarget != Square::undefined)
-                {
-                    // lookup pawn attacks and bitwise AND with en passant square (bit)
-                    const BitBoardState enPassantAttacks =
-                            AttackQueries::pawnAttackTable[Color::White][sourceSquare] &
-                            BitBoardOperations::occupySquare(BoardState::empty, gameState.board.enPassantTarget);
+                        attacks = BitBoardOperations::eraseSquare(attacks, targetSquare);
+                    }
 
-                    // make sure en passant capture possible
-                    if (enPassantAttacks != BoardState::empty)
+                    // generate en passant captures. The captured pawn might be the checker itself.
+                    if (gameState.board.enPassantTarget != Square::undefined &&
+                        (BitBoardOperations::isOccupied(checkMask, gameState.board.enPassantTarget) ||
+                         BitBoardOperations::isOccupied(checkMask, (color == Color::White) ?
+                            BitBoardOperations::getSouthSquareFromGivenSquare(gameState.board.enPassantTarget) :
+                            BitBoardOperations::getNorthSquareFromGivenSquare(gameState.board.enPassantTarget))))
                     {
-                        // init en passant capture target square
-                        const Square targetEnPassant = BitBoardOperations::bitScanForward(enPassantAttacks);
-                        movesToBeGenerated.emplace_back(sourceSquare, targetEnPassant, Figure::WhitePawn, Figure::None,
-                                                        true, false, true, false);
+                        // lookup pawn attacks and bitwise AND with en passant square (bit)
+                        const BitBoardState enPassantAttacks =
+                                AttackQueries::pawnAttackTable[color][sourceSquare] &
+                                BitBoardOperations::occupySquare(BoardState::empty, gameState.board.enPassantTarget);
+
+                        // make sure en passant capture possible
+                        if (enPassantAttacks != BoardState::empty)
+                        {
+                            // init en passant capture target square
+                            const Square targetEnPassant = BitBoardOperations::bitScanForward(enPassantAttacks);
+                            movesToBeGenerated.emplace_back(sourceSquare, targetEnPassant, pawn, Figure::None,
+                                                            true, false, true, false);
+                        }
                     }
                 }
 
-                // pop ls1b from figure whitePawnBitboard copy
-                whitePawnBitboard = BitBoardOperations::eraseSquare(whitePawnBitboard, sourceSquare);
+                // pop ls1b from figure pawnBitboard copy
+                pawnBitboard = BitBoardOperations::eraseSquare(pawnBitboard, sourceSquare);
             }
         }
 
-        static void generateWhiteKingMoves(const GameState &gameState, std::vector<Move> &movesToBeGenerated)
+        template<Color color>
+        static void addPromotions(MoveList &movesToBeGenerated, Square sourceSquare, Square targetSquare, bool isCapture)
         {
+            constexpr Figure pawn = figureOf<color>(Figure::WhitePawn);
+
+            movesToBeGenerated.emplace_back(sourceSquare, targetSquare, pawn, figureOf<color>(Figure::WhiteQueen),
+                                            isCapture, false, false, false);
+            movesToBeGenerated.emplace_back(sourceSquare, targetSquare, pawn, figureOf<color>(Figure::WhiteRook),
+                                            isCapture, false, false, false);
+            movesToBeGenerated.emplace_back(sourceSquare, targetSquare, pawn, figureOf<color>(Figure::WhiteBishop),
+                                            isCapture, false, false, false);
+            movesToBeGenerated.emplace_back(sourceSquare, targetSquare, pawn, figureOf<color>(Figure::WhiteKnight),
+                                            isCapture, false, false, false);
+        }
+
+        template<Color color, MoveCategory category>
+        static void generateKingMoves(const GameState &gameState, MoveList &movesToBeGenerated)
+        {
+            constexpr Figure king = figureOf<color>(Figure::WhiteKing);
+            constexpr auto squareIsAttackedByOpponent = (color == Color::White) ?
+                                                        AttackQueries::squareIsAttackedByBlack :
+                                                        AttackQueries::squareIsAttackedByWhite;
+
+            constexpr Square kingSquare = (color == Color::White) ? Square::e1 : Square::e8;
+            constexpr Square kingSideRookTarget = (color == Color::White) ? Square::f1 : Square::f8;
+            constexpr Square kingSideKingTarget = (color == Color::White) ? Square::g1 : Square::g8;
+            constexpr Square queenSideRookTarget = (color == Color::White) ? Square::d1 : Square::d8;
+            constexpr Square queenSideKingTarget = (color == Color::White) ? Square::c1 : Square::c8;
+            constexpr Square queenSideKnightSquare = (color == Color::White) ? Square::b1 : Square::b8;
+
+            const bool canCastleKingSide = (color == Color::White) ?
+                                           whiteCanCastleKingSide(gameState.board.castlingRights) :
+                                           blackCanCastleKingSide(gameState.board.castlingRights);
+            const bool canCastleQueenSide = (color == Color::White) ?
+                                            whiteCanCastleQueenSide(gameState.board.castlingRights) :
+                                            blackCanCastleQueenSide(gameState.board.castlingRights);
+
+            // castling moves are quiet moves
+            constexpr bool generateCastling = (category == MoveCategory::AllMoves || category == MoveCategory::QuietMoves);
+
             // king side castling is available
-            if (whiteCanCastleKingSide(gameState.board.castlingRights))
+            if (generateCastling && canCastleKingSide)
             {
                 // make sure square between king and king's rook are empty
-                if (!BitBoardOperations::isOccupied(gameState.board.occupancies[Color::Both], f1) &&
-                    !BitBoardOperations::isOccupied(gameState.board.occupancies[Color::Both], g1))
+                if (!BitBoardOperations::isOccupied(gameState.board.occupancies[Color::Both], kingSideRookTarget) &&
+                    !BitBoardOperations::isOccupied(gameState.board.occupancies[Color::Both], kingSideKingTarget))
                 {
-                    // make sure king and the f1 squares are not under attacks.
-                    // The g1 square will be checked in the executeMove() function due to performance reasons
-                    if (!AttackQueries::squareIsAttackedByBlack(gameState.board, Square::e1) &&
-                        !AttackQueries::squareIsAttackedByBlack(gameState.board, Square::f1))
+                    // make sure king and the f1/f8 squares are not under attacks.
+                    // The g1/g8 square will be checked in the executeMove() function due to performance reasons
+                    if (!squareIsAttackedByOpponent(gameState.board, kingSquare) &&
+                        !squareIsAttackedByOpponent(gameState.board, kingSideRookTarget))
                     {
-                        movesToBeGenerated.emplace_back(Square::e1, Square::g1, Figure::WhiteKing, Figure::None, false,
+                        movesToBeGenerated.emplace_back(kingSquare, kingSideKingTarget, king, Figure::None, false,
                                                         false, false, true);
-                        // The rook move to f1 is generated in the rook move generation
+                        // The rook move to f1/f8 is generated in the rook move generation
                     }
                 }
             }
 
             // queen side castling is available
-            if (whiteCanCastleQueenSide(gameState.board.castlingRights))
+            if (generateCastling && canCastleQueenSide)
             {
                 // make sure square between king and queen's rook are empty
-                if (!BitBoardOperations::isOccupied(gameState.board.occupancies[Color::Both], d1) &&
-                    !BitBoardOperations::isOccupied(gameState.board.occupancies[Color::Both], c1) &&
-                    !BitBoardOperations::isOccupied(gameState.board.occupancies[Color::Both], b1))
+                if (!BitBoardOperations::isOccupied(gameState.board.occupancies[Color::Both], queenSideRookTarget) &&
+                    !BitBoardOperations::isOccupied(gameState.board.occupancies[Color::Both], queenSideKingTarget) &&
+                    !BitBoardOperations::isOccupied(gameState.board.occupancies[Color::Both], queenSideKnightSquare))
                 {
-                    // make sure king and the d1 squares are not under attacks
-                    // The c1 square will be checked in the executeMove() function due to performance reasons
-                    if (!AttackQueries::squareIsAttackedByBlack(gameState.board, e1) &&
-                        !AttackQueries::squareIsAttackedByBlack(gameState.board, d1))
+                    // make sure king and the d1/d8 squares are not under attacks
+                    // The c1/c8 square will be checked in the executeMove() function due to performance reasons
+                    if (!squareIsAttackedByOpponent(gameState.board, kingSquare) &&
+                        !squareIsAttackedByOpponent(gameState.board, queenSideRookTarget))
                     {
-                        movesToBeGenerated.emplace_back(Square::e1, Square::c1, Figure::WhiteKing, Figure::None, false,
+                        movesToBeGenerated.emplace_back(kingSquare, queenSideKingTarget, king, Figure::None, false,
                                                         false, false, true);
-                        // The rook move to d1 is generated in the rook move generation
+                        // The rook move to d1/d8 is generated in the rook move generation
                     }
                 }
             }
 
-            std::function<BitBoardState(Square)> getAttacks = [&gameState](Square sourceSquare)
-            {
-                return AttackQueries::kingAttackTable[sourceSquare] & (~gameState.board.occupancies[Color::White]);
-            };
-
-            generatePieceMoves(gameState, movesToBeGenerated, Color::Black, Figure::WhiteKing, std::move(getAttacks));
+            generatePieceMoves<color, king, category>(gameState, movesToBeGenerated);
         }
 
+        /**
+         * @param checkMask restricts the target squares, e.g. for resolving a check
+         */
+        template<Color color, Figure piece, MoveCategory category>
         static void generatePieceMoves(const GameState &gameState,
-                                       std::vector<Move> &movesToBeGenerated,
-                                       Color opponentsColor,
-                                       Figure piece,
-                                       std::function<BitBoardState(Square)> getAttacks)
+                                       MoveList &movesToBeGenerated,
+                                       BitBoardState checkMask = BoardState::allSquaresOccupied)
         {
+            const BitBoardState targetMask = getTargetMask<color, category>(gameState.board) & checkMask;
+
             BitBoardState pieceBitboard = gameState.board.bitboards[piece];
 
             // loop over source squares of piece pieceBitboard copy
@@ -321,197 +436,224 @@ namespace ModernChess
                 const Square sourceSquare = BitBoardOperations::bitScanForward(pieceBitboard);
 
                 // init piece attacks in order to get set of target squares
-                BitBoardState attacks = getAttacks(sourceSquare);
-
-                // loop over target squares available from generated attacks
-                while (attacks != BoardState::empty)
-                {
-                    // init target square
-                    const Square targetSquare = BitBoardOperations::bitScanForward(attacks);
+                const BitBoardState attacks = getPieceAttacks<piece>(sourceSquare, gameState.board.occupancies[Color::Both]) &
+                                              targetMask;
 
-                    if (BitBoardOperations::isOccupied(gameState.board.occupancies[opponentsColor], targetSquare))
-                    {
-                        // capture move
-                        movesToBeGenerated.emplace_back(sourceSquare, targetSquare, piece, Figure::None, true, false,
-                                                        false, false);
-                    }
-                    else
-                    {
-                        // quiet move
-                        movesToBeGenerated.emplace_back(sourceSquare, targetSquare, piece, Figure::None, false, false,
-                                                        false, false);
-                    }
-
-                    // pop ls1b in current attacks set
-                    attacks = BitBoardOperations::eraseSquare(attacks, targetSquare);
-                }
+                addPieceMoves<color, piece>(gameState, movesToBeGenerated, sourceSquare, attacks);
 
                 // pop ls1b of the current piece pieceBitboard copy
                 pieceBitboard = BitBoardOperations::eraseSquare(pieceBitboard, sourceSquare);
             }
         }
 
-        static void generateBlackPawnMoves(const GameState &gameState, std::vector<Move> &movesToBeGenerated)
+        template<Color color>
+        [[nodiscard]] static bool isPseudoLegal(const Board &board, Move move)
         {
-            BitBoardState blackPawnBitboard = gameState.board.bitboards[Figure::BlackPawn];
+            constexpr Color opponentsColor = opponentOf<color>();
+            constexpr Figure pawn = figureOf<color>(Figure::WhitePawn);
+            constexpr Figure knight = figureOf<color>(Figure::WhiteKnight);
+            constexpr Figure bishop = figureOf<color>(Figure::WhiteBishop);
+            constexpr Figure rook = figureOf<color>(Figure::WhiteRook);
+            constexpr Figure queen = figureOf<color>(Figure::WhiteQueen);
+            constexpr Figure king = figureOf<color>(Figure::WhiteKing);
+
+            if (move.isNullMove())
+            {
+                return false;
+            }
+
+            const Square sourceSquare = move.getFrom();
+            const Square targetSquare = move.getTo();
+            const Figure movedFigure = move.getMovedFigure();
 
-            // loop over white pawns within black pawn bitboard
-            while (blackPawnBitboard != BoardState::empty)
+            // The moved figure has to belong to the side to move and has to stand on the source square
+            if (movedFigure < pawn || movedFigure > king ||
+                !BitBoardOperations::isOccupied(board.bitboards[movedFigure], sourceSquare) ||
+                BitBoardOperations::isOccupied(board.occupancies[color], targetSquare))
             {
-                const Square sourceSquare = BitBoardOperations::bitScanForward(blackPawnBitboard);
+                return false;
+            }
 
-                {
-                    // Black pawns are moving towards south direction
-                    // generate quite pawn moves
-                    const Square targetSquare = BitBoardOperations::getSouthSquareFromGivenSquare(sourceSquare);
+            if (movedFigure == pawn)
+            {
+                return pawnMoveIsPseudoLegal<color>(board, move);
+            }
 
-                    if (const bool targetSquareIsOnBoard = (targetSquare >= Square::a1);
-                            targetSquareIsOnBoard &&
-                            !BitBoardOperations::isOccupied(gameState.board.occupancies[Color::Both], targetSquare))
-                    {
-                        // pawn promotion
-                        if (sourceSquare >= a2 && sourceSquare <= h2)
-                        {
-                            movesToBeGenerated.emplace_back(sourceSquare, targetSquare, Figure::BlackPawn,
-                                                            Figure::BlackQueen,
-                                                            false, false, false, false);
-                            movesToBeGenerated.emplace_back(sourceSquare, targetSquare, Figure::BlackPawn,
-                                                            Figure::BlackRook,
-                                                            false, false, false, false);
-                            movesToBeGenerated.emplace_back(sourceSquare, targetSquare, Figure::BlackPawn,
-                                                            Figure::BlackBishop,
-                                                            false, false, false, false);
-                            movesToBeGenerated.emplace_back(sourceSquare, targetSquare, Figure::BlackPawn,
-                                                            Figure::BlackKnight,
-                                                            false, false, false, false);
-                        }
-                        else
-                        {
-                            // single pawn push
-                            movesToBeGenerated.emplace_back(sourceSquare, targetSquare, Figure::BlackPawn, Figure::None,
-                                                            false, false, false, false);
+            // Only pawns are able to promote, to do double pushes or en passant captures
+            if (move.getPromotedPiece() != Figure::None || move.isDoublePawnPush() || move.isEnPassantCapture() ||
+                move.isCapture() != BitBoardOperations::isOccupied(board.occupancies[opponentsColor], targetSquare))
+            {
+                return false;
+            }
 
-                            // double pawn push
-                            if ((sourceSquare >= a7 && sourceSquare <= h7) &&
-                                !BitBoardOperations::isOccupied(gameState.board.occupancies[Color::Both],
-                                                                BitBoardOperations::getSouthSquareFromGivenSquare(
-                                                                        targetSquare)))
-                            {
-                                movesToBeGenerated.emplace_back(sourceSquare,
-                                                                BitBoardOperations::getSouthSquareFromGivenSquare(
-                                                                        targetSquare), Figure::BlackPawn, Figure::None,
-                                                                false, true, false, false);
-                            }
-                        }
-                    }
-                }
+            const BitBoardState occupancy = board.occupancies[Color::Both];
 
-                // init pawn attacks of blackPawnBitboard and generate pawn captures
-                for (BitBoardState attacks = AttackQueries::pawnAttackTable[Color::Black][sourceSquare] &
-                                             gameState.board.occupancies[Color::White];
-                     attacks != BoardState::empty;
-                        )
-                {
-                    // init target square
-                    const Square targetSquare = BitBoardOperations::bitScanForward(attacks);
+            switch (movedFigure)
+            {
+                case knight:
+                    return !move.isCastlingMove() &&
+                           BitBoardOperations::isOccupied(getPieceAttacks<knight>(sourceSquare, occupancy), targetSquare);
+                case bishop:
+                    return !move.isCastlingMove() &&
+                           BitBoardOperations::isOccupied(getPieceAttacks<bishop>(sourceSquare, occupancy), targetSquare);
+                case rook:
+                    return !move.isCastlingMove() &&
+                           BitBoardOperations::isOccupied(getPieceAttacks<rook>(sourceSquare, occupancy), targetSquare);
+                case queen:
+                    return !move.isCastlingMove() &&
+                           BitBoardOperations::isOccupied(getPieceAttacks<queen>(sourceSquare, occupancy), targetSquare);
+                default:
+                    return move.isCastlingMove() ?
+                           castlingIsPseudoLegal<color>(board, sourceSquare, targetSquare) :
+                           BitBoardOperations::isOccupied(getPieceAttacks<king>(sourceSquare, occupancy), targetSquare);
+            }
+        }
 
-                    // pawn promotion
-                    if (sourceSquare >= a2 && sourceSquare <= h2)
-                    {
-                        movesToBeGenerated.emplace_back(sourceSquare, targetSquare, Figure::BlackPawn,
-                                                        Figure::BlackQueen,
-                                                        true, false, false, false);
-                        movesToBeGenerated.emplace_back(sourceSquare, targetSquare, Figure::BlackPawn,
-                                                        Figure::BlackRook,
-                                                        true, false, false, false);
-                        movesToBeGenerated.emplace_back(sourceSquare, targetSquare, Figure::BlackPawn,
-                                                        Figure::BlackBishop,
-                                                        true, false, false, false);
-                        movesToBeGenerated.emplace_back(sourceSquare, targetSquare, Figure::BlackPawn,
-                                                        Figure::BlackKnight,
-                                                        true, false, false, false);
-                    }
-                    else
-                    {
-                        // one square ahead pawn move
-                        movesToBeGenerated.emplace_back(sourceSquare, targetSquare, Figure::BlackPawn, Figure::None,
-                                                        true,
-                                                        false, false, false);
-                    }
+        template<Color color>
+        [[nodiscard]] static bool pawnMoveIsPseudoLegal(const Board &board, Move move)
+        {
+            constexpr Color opponentsColor = opponentOf<color>();
 
-                    attacks = BitBoardOperations::eraseSquare(attacks, targetSquare);
-                }
+            // White pawns are moving towards north direction and black pawns towards south direction
+            constexpr auto pushSquare = [](Square square) {
+                return (color == Color::White) ? BitBoardOperations::getNorthSquareFromGivenSquare(square) :
+                                                 BitBoardOperations::getSouthSquareFromGivenSquare(square);
+            };
 
-                // generate en passant captures
-                if (gameState.board.enPassantTarget != Square::undefined)
-                {
-                    // lookup pawn attacks and bitwise AND with en passant square (bit)
-                    const BitBoardState enPassantAttacks =
-                            AttackQueries::pawnAttackTable[Color::Black][sourceSquare] &
-                            BitBoardOperations::occupySquare(BoardState::empty, gameState.board.enPassantTarget);
+            constexpr Square promotionRankStart = (color == Color::White) ? Square::a7 : Square::a2;
+            constexpr Square promotionRankEnd = (color == Color::White) ? Square::h7 : Square::h2;
+            constexpr Square doublePushRankStart = (color == Color::White) ? Square::a2 : Square::a7;
+            constexpr Square doublePushRankEnd = (color == Color::White) ? Square::h2 : Square::h7;
+
+            const Square sourceSquare = move.getFrom();
+            const Square targetSquare = move.getTo();
+            const Figure promotedPiece = move.getPromotedPiece();
+            const bool isPromotion = (sourceSquare >= promotionRankStart && sourceSquare <= promotionRankEnd);
+
+            // Pawns on the promotion rank have to promote to one of the own figures and all others must not
+            if (move.isCastlingMove() ||
+                isPromotion != (promotedPiece != Figure::None) ||
+                (isPromotion && promotedPiece != figureOf<color>(Figure::WhiteQueen) &&
+                                promotedPiece != figureOf<color>(Figure::WhiteRook) &&
+                                promotedPiece != figureOf<color>(Figure::WhiteBishop) &&
+                                promotedPiece != figureOf<color>(Figure::WhiteKnight)))
+            {
+                return false;
+            }
 
-                    // make sure en passant capture possible
-                    if (enPassantAttacks != BoardState::empty)
-                    {
-                        // init en passant capture target square
-                        const Square targetEnPassant = BitBoardOperations::bitScanForward(enPassantAttacks);
-                        movesToBeGenerated.emplace_back(sourceSquare, targetEnPassant, Figure::BlackPawn, Figure::None,
-                                                        true, false, true, false);
-                    }
-                }
+            if (move.isEnPassantCapture())
+            {
+                return move.isCapture() && !move.isDoublePawnPush() &&
+                       board.enPassantTarget != Square::undefined &&
+                       targetSquare == board.enPassantTarget &&
+                       BitBoardOperations::isOccupied(AttackQueries::pawnAttackTable[color][sourceSquare], targetSquare);
+            }
 
-                // pop ls1b from figure blackPawnBitboard copy
-                blackPawnBitboard = BitBoardOperations::eraseSquare(blackPawnBitboard, sourceSquare);
+            if (move.isCapture())
+            {
+                return !move.isDoublePawnPush() &&
+                       BitBoardOperations::isOccupied(board.occupancies[opponentsColor], targetSquare) &&
+                       BitBoardOperations::isOccupied(AttackQueries::pawnAttackTable[color][sourceSquare], targetSquare);
             }
+
+            const BitBoardState occupancy = board.occupancies[Color::Both];
+            const Square singlePushTarget = pushSquare(sourceSquare);
+
+            if (move.isDoublePawnPush())
+            {
+                return sourceSquare >= doublePushRankStart && sourceSquare <= doublePushRankEnd &&
+                       targetSquare == pushSquare(singlePushTarget) &&
+                       !BitBoardOperations::isOccupied(occupancy, singlePushTarget) &&
+                       !BitBoardOperations::isOccupied(occupancy, targetSquare);
+            }
+
+            return targetSquare == singlePushTarget && !BitBoardOperations::isOccupied(occupancy, targetSquare);
         }
 
-        static void generateBlackKingMoves(const GameState &gameState, std::vector<Move> &movesToBeGenerated)
+        /**
+         * @brief Same conditions as in generateKingMoves()
+         */
+        template<Color color>
+        [[nodiscard]] static bool castlingIsPseudoLegal(const Board &board, Square sourceSquare, Square targetSquare)
         {
-            // king side castling is available
-            if (blackCanCastleKingSide(gameState.board.castlingRights))
+            constexpr auto squareIsAttackedByOpponent = (color == Color::White) ?
+                                                        AttackQueries::squareIsAttackedByBlack :
+                                                        AttackQueries::squareIsAttackedByWhite;
+
+            constexpr Square kingSquare = (color == Color::White) ? Square::e1 : Square::e8;
+            constexpr Square kingSideRookTarget = (color == Color::White) ? Square::f1 : Square::f8;
+            constexpr Square kingSideKingTarget = (color == Color::White) ? Square::g1 : Square::g8;
+            constexpr Square queenSideRookTarget = (color == Color::White) ? Square::d1 : Square::d8;
+            constexpr Square queenSideKingTarget = (color == Color::White) ? Square::c1 : Square::c8;
+            constexpr Square queenSideKnightSquare = (color == Color::White) ? Square::b1 : Square::b8;
+
+            const BitBoardState occupancy = board.occupancies[Color::Both];
+
+            if (sourceSquare != kingSquare)
             {
-                // make sure square between king and king's rook are empty
-                if (!BitBoardOperations::isOccupied(gameState.board.occupancies[Color::Both], f8) &&
-                    !BitBoardOperations::isOccupied(gameState.board.occupancies[Color::Both], g8))
-                {
-                    // make sure king and the f8 squares are not under attacks.
-                    // The g1 square will be checked in the executeMove() function due to performance reasons
-                    if (!AttackQueries::squareIsAttackedByWhite(gameState.board, Square::e8) &&
-                        !AttackQueries::squareIsAttackedByWhite(gameState.board, Square::f8))
-                    {
-                        movesToBeGenerated.emplace_back(Square::e8, Square::g8, Figure::BlackKing, Figure::None, false,
-                                                        false, false, true);
-                        // The rook move to f1 is generated in the rook move generation
-                    }
-                }
+                return false;
             }
 
-            // queen side castling is available
-            if (blackCanCastleQueenSide(gameState.board.castlingRights))
+            if (targetSquare == kingSideKingTarget)
             {
-                // make sure square between king and queen's rook are empty
-                if (!BitBoardOperations::isOccupied(gameState.board.occupancies[Color::Both], d8) &&
-                    !BitBoardOperations::isOccupied(gameState.board.occupancies[Color::Both], c8) &&
-                    !BitBoardOperations::isOccupied(gameState.board.occupancies[Color::Both], b8))
-                {
-                    // make sure king and the d8 squares are not under attacks
-                    // The c8 square will be checked in the executeMove() function due to performance reasons
-                    if (!AttackQueries::squareIsAttackedByWhite(gameState.board, e8) &&
-                        !AttackQueries::squareIsAttackedByWhite(gameState.board, d8))
-                    {
-                        movesToBeGenerated.emplace_back(Square::e8, Square::c8, Figure::BlackKing, Figure::None, false,
-                                                        false, false, true);
-                        // The rook move to d1 is generated in the rook move generation
-                    }
-                }
+                const bool canCastleKingSide = (color == Color::White) ?
+                                               whiteCanCastleKingSide(board.castlingRights) :
+                                               blackCanCastleKingSide(board.castlingRights);
+
+                return canCastleKingSide &&
+                       !BitBoardOperations::isOccupied(occupancy, kingSideRookTarget) &&
+                       !BitBoardOperations::isOccupied(occupancy, kingSideKingTarget) &&
+                       !squareIsAttackedByOpponent(board, kingSquare) &&
+                       !squareIsAttackedByOpponent(board, kingSideRookTarget);
             }
 
-            std::function<BitBoardState(Square)> getAttacks = [&gameState](Square sourceSquare)
+            if (targetSquare == queenSideKingTarget)
             {
-                return AttackQueries::kingAttackTable[sourceSquare] & (~gameState.board.occupancies[Color::Black]);
-            };
+                const bool canCastleQueenSide = (color == Color::White) ?
+                                                whiteCanCastleQueenSide(board.castlingRights) :
+                                                blackCanCastleQueenSide(board.castlingRights);
+
+                return canCastleQueenSide &&
+                       !BitBoardOperations::isOccupied(occupancy, queenSideRookTarget) &&
+                       !BitBoardOperations::isOccupied(occupancy, queenSideKingTarget) &&
+                       !BitBoardOperations::isOccupied(occupancy, queenSideKnightSquare) &&
+                       !squareIsAttackedByOpponent(board, kingSquare) &&
+                       !squareIsAttackedByOpponent(board, queenSideRookTarget);
+            }
+
+            return false;
+        }
+
+        template<Color color, Figure piece>
+        static void addPieceMoves(const GameState &gameState,
+                                  MoveList &movesToBeGenerated,
+                                  Square sourceSquare,
+                                  BitBoardState attacks)
+        {
+            constexpr Color opponentsColor = opponentOf<color>();
 
-            generatePieceMoves(gameState, movesToBeGenerated, Color::White, Figure::BlackKing, std::move(getAttacks));
+            // loop over target squares available from generated attacks
+            while (attacks != BoardState::empty)
+            {
+                // init target square
+                const Square targetSquare = BitBoardOperations::bitScanForward(attacks);
+
+                if (BitBoardOperations::isOccupied(gameState.board.occupancies[opponentsColor], targetSquare))
+                {
+                    // capture move
+                    movesToBeGenerated.emplace_back(sourceSquare, targetSquare, piece, Figure::None, true, false,
+                                                    false, false);
+                }
+                else
+                {
+                    // quiet move
+                    movesToBeGenerated.emplace_back(sourceSquare, targetSquare, piece, Figure::None, false, false,
+                                                    false, false);
+                }
+
+                // pop ls1b in current attacks set
+                attacks = BitBoardOperations::eraseSquare(attacks, targetSquare);
+            }
         }
     };
-}
\ No newline at end of file
+}
@@ -9,7 +9,7 @@ namespace ModernChess {
         /**
         * @return generates 32-bit pseudo legal numbers
         */
-        [[nodiscard]] uint32_t getRandomU32Number()
+        [[nodiscard]] constexpr uint32_t getRandomU32Number()
         {
             // pseudo random number state1
 
@@ -28,20 +28,24 @@ namespace ModernChess {
             return number;
         }
 
-        /// generate 64-bit pseudo legal numbers
-        [[nodiscard]] uint64_t getRandomU64Number()
+        /**
+         * @brief Slicing four 32-bit numbers of the 32-bit state would yield Zobrist keys,
+         *        which only span 32 bits. Therefore, 64-bit numbers are generated with
+         *        the xorshift64* algorithm and a separate 64-bit state.
+         * @see https://www.chessprogramming.org/Pseudorandom_Number_Generator#Xorshift64star
+         * @return generates 64-bit pseudo legal numbers
+         */
+        [[nodiscard]] constexpr uint64_t getRandomU64Number()
         {
-            // init random numbers slicing 16 bits from MS1B side
-            const auto n1 = uint64_t(getRandomU32Number()) & 0xFFFF;
-            const auto n2 = uint64_t(getRandomU32Number()) & 0xFFFF;
-            const auto n3 = uint64_t(getRandomU32Number()) & 0xFFFF;
-            const auto n4 = uint64_t(getRandomU32Number()) & 0xFFFF;
+            state64 ^= state64 >> 12;
+            state64 ^= state64 << 25;
+            state64 ^= state64 >> 27;
 
-            // return random number
-            return n1 | (n2 << 16) | (n3 << 32) | (n4 << 48);
+            return state64 * 2685821657736338717ULL;
         }
 
     private:
         uint32_t state = 1804289383; // initial state
+        uint64_t state64 = 1070372; // initial state of the 64-bit generator
     };
 }
\ No newline at end of file
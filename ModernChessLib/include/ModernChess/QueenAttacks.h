@@ -8,7 +8,7 @@ namespace ModernChess {
     class QueenAttacks
     {
     public:
-        explicit QueenAttacks(const BishopAttacks &bishopAttacks,
+        constexpr explicit QueenAttacks(const BishopAttacks &bishopAttacks,
                               const RookAttacks &rookAttacks) :
                 m_bishopAttacks(bishopAttacks),
                 m_rookAttacks(rookAttacks) {}
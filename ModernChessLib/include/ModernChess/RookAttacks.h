@@ -5,6 +5,7 @@
 #include "PawnPushes.h"
 #include "Square.h"
 #include "Figure.h"
+#include "SliderIndexing.h"
 
 #include <array>
 
@@ -29,7 +30,7 @@ namespace ModernChess {
                     12, 11, 11, 11, 11, 11, 11, 12
             };
 
-            // Generated by test/MagicNumberCandidateGeneration.cpp
+            // Generated by tools/MagicNumberGeneration.cpp
             constexpr std::array<uint64_t, 64> magicNumbers{
                     0x8a80104000800020ULL,
                     0x140002000100040ULL,
@@ -96,6 +97,12 @@ namespace ModernChess {
                     0x2006104900a0804ULL,
                     0x1004081002402ULL
             };
+
+            // Start of every square in the shared attack table
+            constexpr std::array<uint32_t, 64> tableOffsets = SliderIndexingFunctions::getTableOffsets(relevantBits);
+
+            // Number of entries of the shared attack table
+            constexpr size_t tableSize = SliderIndexingFunctions::getTableSize(relevantBits);
         };
 
         // mask rook attacks
@@ -203,25 +210,71 @@ namespace ModernChess {
             // return attack map
             return attacks;
         }
+
+        [[nodiscard]] constexpr std::array<BitBoardState, 64> generateRookAttackMasks()
+        {
+            std::array<BitBoardState, 64> attackMasks{};
+
+            for (Square square = Square::a1; square <= Square::h8; ++square)
+            {
+                attackMasks[square] = maskRookAttacks(square);
+            }
+
+            return attackMasks;
+        }
+
+        [[nodiscard]] constexpr SliderIndexingFunctions::AttackTables<RookMetaData::tableSize> generateRookAttackTables()
+        {
+            constexpr std::array<SliderIndexingFunctions::Direction, 4> directions{{{1, 0}, {-1, 0}, {0, 1}, {0, -1}}};
+
+            return SliderIndexingFunctions::generateAttackTables<RookMetaData::tableSize>(directions,
+                                                                                          generateRookAttackMasks(),
+                                                                                          RookMetaData::relevantBits,
+                                                                                          RookMetaData::magicNumbers);
+        }
     }
 
     class RookAttacks {
     public:
-        RookAttacks();
+        /**
+         * @param requestedIndexing PEXT falls back to magic numbers, if the CPU doesn't support it
+         */
+        explicit RookAttacks(SliderIndexing requestedIndexing = SliderIndexingFunctions::getDefaultIndexing());
 
         [[nodiscard]] inline BitBoardState getAttacks(Square square, BitBoardState occupiedSquares) const
         {
+#ifdef MODERN_CHESS_USE_PEXT
+            if (indexing == SliderIndexing::Pext)
+            {
+                return pextAttacks[RookAttackHelperFunctions::RookMetaData::tableOffsets[square] +
+                                   SliderIndexingFunctions::extractBits(occupiedSquares, attackMasks[square])];
+            }
+#endif
             occupiedSquares &= attackMasks[square];
             occupiedSquares *= RookAttackHelperFunctions::RookMetaData::magicNumbers[square];
             occupiedSquares >>= 64 - RookAttackHelperFunctions::RookMetaData::relevantBits[square];
 
-            return rookAttacks[square][occupiedSquares];
+            return magicAttacks[RookAttackHelperFunctions::RookMetaData::tableOffsets[square] + occupiedSquares];
+        }
+
+        [[nodiscard]] SliderIndexing getIndexing() const
+        {
+            return indexing;
         }
+
     private:
+        SliderIndexing indexing;
+
         // rook attack masks
-        std::array<BitBoardState, 64> attackMasks{};
+        static constexpr std::array<BitBoardState, 64> attackMasks =
+                RookAttackHelperFunctions::generateRookAttackMasks();
+
+        // rook attacks table with magic index [tableOffsets[square] + magic index]
+        static const std::array<BitBoardState, RookAttackHelperFunctions::RookMetaData::tableSize> magicAttacks;
 
-        // rook attacks table [square][occupancies]
-        std::array<std::array<BitBoardState, 4096>, 64>  rookAttacks{};
+#ifdef MODERN_CHESS_USE_PEXT
+        // rook attacks table with PEXT index [tableOffsets[square] + PEXT index]
+        static const std::array<BitBoardState, RookAttackHelperFunctions::RookMetaData::tableSize> pextAttacks;
+#endif
     };
 }
\ No newline at end of file
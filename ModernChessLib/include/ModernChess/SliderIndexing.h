@@ -0,0 +1,196 @@
+#pragma once
+
+#include "BitBoardConstants.h"
+#include "BitBoardOperations.h"
+#include "Square.h"
+
+#include <array>
+#include <cstddef>
+
+#ifdef MODERN_CHESS_USE_PEXT
+#include <immintrin.h>
+#endif
+
+namespace ModernChess {
+
+    /**
+     * @brief Maps the relevant occupancy of a sliding figure to an index of its attack table
+     */
+    enum class SliderIndexing
+    {
+        /**
+         * @brief Multiplies the relevant occupancy with a magic number and shifts the result
+         * @see https://www.chessprogramming.org/Magic_Bitboards
+         */
+        Magic,
+        /**
+         * @brief Extracts the relevant occupancy bits with the BMI2 instruction PEXT.
+         *        Only available, if the library has been built with MODERN_CHESS_USE_PEXT
+         *        and the CPU supports BMI2.
+         * @see https://www.chessprogramming.org/BMI2#PEXTBitboards
+         */
+        Pext
+    };
+
+    namespace SliderIndexingFunctions
+    {
+        /**
+         * @brief Every square gets as many table entries as its relevant occupancy bits can index
+         *        instead of the maximum of all squares ("fancy" magic bitboards).
+         * @return Start of every square in the attack table, which is shared by all squares
+         * @see https://www.chessprogramming.org/Magic_Bitboards#Fancy
+         */
+        [[nodiscard]] constexpr std::array<uint32_t, 64> getTableOffsets(const std::array<uint32_t, 64> &relevantBits)
+        {
+            std::array<uint32_t, 64> offsets{};
+            uint32_t offset = 0;
+
+            for (size_t square = 0; square < offsets.size(); ++square)
+            {
+                offsets[square] = offset;
+                offset += 1U << relevantBits[square];
+            }
+
+            return offsets;
+        }
+
+        /**
+         * @return Number of entries of the attack table, which is shared by all squares
+         */
+        [[nodiscard]] constexpr size_t getTableSize(const std::array<uint32_t, 64> &relevantBits)
+        {
+            size_t size = 0;
+
+            for (const uint32_t numberOfBits : relevantBits)
+            {
+                size += size_t(1) << numberOfBits;
+            }
+
+            return size;
+        }
+
+        /**
+         * @brief Direction of a ray of a sliding figure
+         */
+        struct Direction
+        {
+            int rankDirection;
+            int fileDirection;
+        };
+
+        /**
+         * @return Squares from the given square (exclusive) to the edge of the board in the given direction
+         */
+        [[nodiscard]] constexpr BitBoardState getRay(Square square, Direction direction)
+        {
+            BitBoardState ray = BoardState::empty;
+
+            for (int rank = square / 8 + direction.rankDirection, file = square % 8 + direction.fileDirection;
+                 rank >= 0 && rank <= 7 && file >= 0 && file <= 7;
+                 rank += direction.rankDirection, file += direction.fileDirection)
+            {
+                ray = BitBoardOperations::occupySquare(ray, BitBoardOperations::getSquare(rank, file));
+            }
+
+            return ray;
+        }
+
+        /**
+         * @brief Attack tables of a sliding figure for both kinds of indexing
+         */
+        template<size_t tableSize>
+        struct AttackTables
+        {
+            std::array<BitBoardState, tableSize> magicAttacks{};
+            std::array<BitBoardState, tableSize> pextAttacks{};
+        };
+
+        /**
+         * @brief Generates the attack tables of a sliding figure at compile time.
+         *        The relevant occupancies of a square are enumerated with the Carry-Rippler trick in the order
+         *        of their PEXT index. Therefore, PEXT isn't required for generating its table.
+         *        The attacks of a ray are cut behind its first blocker, instead of walking the ray square by square,
+         *        and both tables are filled in the same pass, which keeps the compile time low.
+         * @see https://www.chessprogramming.org/Traversing_Subsets_of_a_Set#All_Subsets_of_any_Set
+         * @see https://www.chessprogramming.org/Classical_Approach
+         */
+        template<size_t tableSize>
+        [[nodiscard]] constexpr AttackTables<tableSize> generateAttackTables(
+                const std::array<Direction, 4> &directions,
+                const std::array<BitBoardState, 64> &attackMasks,
+                const std::array<uint32_t, 64> &relevantBits,
+                const std::array<uint64_t, 64> &magicNumbers)
+        {
+            AttackTables<tableSize> attackTables{};
+            const std::array<uint32_t, 64> tableOffsets = getTableOffsets(relevantBits);
+
+            // rays [direction][square]
+            std::array<std::array<BitBoardState, 64>, 4> rays{};
+
+            for (size_t direction = 0; direction < directions.size(); ++direction)
+            {
+                for (Square square = Square::a1; square <= Square::h8; ++square)
+                {
+                    rays[direction][square] = getRay(square, directions[direction]);
+                }
+            }
+
+            for (Square square = Square::a1; square <= Square::h8; ++square)
+            {
+                const BitBoardState attackMask = attackMasks[square];
+                BitBoardState occupancy = BoardState::empty;
+                uint32_t pextIndex = 0;
+
+                do
+                {
+                    BitBoardState attacks = BoardState::empty;
+
+                    for (size_t direction = 0; direction < directions.size(); ++direction)
+                    {
+                        const BitBoardState ray = rays[direction][square];
+                        attacks |= ray;
+
+                        if (const BitBoardState blockers = ray & occupancy; blockers != BoardState::empty)
+                        {
+                            // The nearest blocker of rays towards higher squares is the least significant bit
+                            const bool rayIsAscending = directions[direction].rankDirection > 0 ||
+                                    (directions[direction].rankDirection == 0 && directions[direction].fileDirection > 0);
+                            const Square blocker = rayIsAscending ? BitBoardOperations::bitScanForward(blockers) :
+                                                                    BitBoardOperations::bitScanReverse(blockers);
+                            attacks &= ~rays[direction][blocker];
+                        }
+                    }
+
+                    const uint32_t magicIndex = uint32_t((occupancy * magicNumbers[square]) >> (64 - relevantBits[square]));
+
+                    attackTables.magicAttacks[tableOffsets[square] + magicIndex] = attacks;
+                    attackTables.pextAttacks[tableOffsets[square] + pextIndex] = attacks;
+
+                    ++pextIndex;
+                    occupancy = (occupancy - attackMask) & attackMask;
+                } while (occupancy != BoardState::empty);
+            }
+
+            return attackTables;
+        }
+
+        /**
+         * @return true, if PEXT has been enabled at build time and the CPU supports BMI2
+         */
+        [[nodiscard]] bool cpuSupportsPext();
+
+        /**
+         * @return PEXT if the CPU supports it, otherwise magic numbers
+         */
+        [[nodiscard]] SliderIndexing getDefaultIndexing();
+
+#ifdef MODERN_CHESS_USE_PEXT
+        // Only compiled for BMI2, so the rest of the library still runs on CPUs without BMI2
+        [[nodiscard]] __attribute__((target("bmi2"))) inline uint64_t extractBits(BitBoardState occupiedSquares,
+                                                                                BitBoardState attackMask)
+        {
+            return _pext_u64(occupiedSquares, attackMask);
+        }
+#endif
+    }
+}
@@ -22,13 +22,13 @@ namespace ModernChess {
     };
 
     // This makes it possible to use Square in for-loops
-    inline Square& operator++(Square& state)
+    constexpr Square& operator++(Square& state)
     {
         state = Square(int(state)+1);
         return state;
     }
 
-    inline Square& operator--(Square& state)
+    constexpr Square& operator--(Square& state)
     {
         state = Square(int(state)-1);
         return state;
@@ -0,0 +1,41 @@
+#pragma once
+
+#include "Board.h"
+#include "GlobalConstants.h"
+#include "Move.h"
+
+#include <array>
+
+namespace ModernChess
+{
+    /**
+     * @brief Evaluates the material, which is won or lost by the exchanges on the target square of a capture.
+     *        Both sides recapture with their least valuable attacker and may stop capturing at any time.
+     * @see https://www.chessprogramming.org/Static_Exchange_Evaluation
+     */
+    class StaticExchangeEvaluation
+    {
+    public:
+        /**
+         * @return The material gain (positive) or loss (negative) of the side to move
+         */
+        [[nodiscard]] static int32_t evaluate(const Board &board, Move move);
+
+        // figure values [figure], the value of Figure::None is 0
+        static constexpr std::array<int32_t, NumberOfFigureTypes + 1> figureValues {
+            100, 300, 350, 500, 1000, 10000,
+            100, 300, 350, 500, 1000, 10000,
+            0
+        };
+
+    private:
+        // At most 32 figures can take part in an exchange
+        static constexpr size_t MaxNumberOfExchanges = 32;
+
+        /**
+         * @param attackers attackers of both colors
+         * @return The least valuable figure of the given color within the attackers or Figure::None
+         */
+        [[nodiscard]] static Figure getLeastValuableAttacker(const Board &board, BitBoardState attackers, Color color);
+    };
+}
@@ -0,0 +1,73 @@
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cinttypes>
+
+namespace ModernChess
+{
+    /**
+     * @brief Tells a running search to stop. The stop flag is set by other threads, e.g. by the UCI thread on a stop
+     *        command or by a deadline timer. The search threads only read the flag and check the clock every
+     *        N nodes, so no lock and no clock read is needed per node.
+     */
+    class StopSignal
+    {
+    public:
+        using Clock = std::chrono::steady_clock;
+
+        static constexpr uint64_t DefaultNodesBetweenTimeChecks = 2048;
+
+        explicit StopSignal(uint64_t nodesBetweenTimeChecks = DefaultNodesBetweenTimeChecks) :
+                m_nodesBetweenTimeChecks(nodesBetweenTimeChecks)
+        {}
+
+        /**
+         * @brief Prepares the signal for a new search, which has to stop at the given time point
+         */
+        void reset(Clock::time_point deadline = Clock::time_point::max())
+        {
+            m_deadline.store(deadline.time_since_epoch().count(), std::memory_order_relaxed);
+            m_stopped.store(false, std::memory_order_relaxed);
+        }
+
+        void stop()
+        {
+            m_stopped.store(true, std::memory_order_relaxed);
+        }
+
+        [[nodiscard]] bool isStopped() const
+        {
+            return m_stopped.load(std::memory_order_relaxed);
+        }
+
+        /**
+         * @brief Stops the search, if the deadline has passed
+         * @return true, if the search has been stopped
+         */
+        bool checkDeadline()
+        {
+            if (Clock::now().time_since_epoch().count() >= m_deadline.load(std::memory_order_relaxed))
+            {
+                stop();
+            }
+
+            return isStopped();
+        }
+
+        [[nodiscard]] uint64_t nodesBetweenTimeChecks() const
+        {
+            return m_nodesBetweenTimeChecks;
+        }
+
+        void setNodesBetweenTimeChecks(uint64_t nodesBetweenTimeChecks)
+        {
+            m_nodesBetweenTimeChecks = nodesBetweenTimeChecks;
+        }
+
+    private:
+        std::atomic<bool> m_stopped{};
+        std::atomic<Clock::rep> m_deadline{Clock::time_point::max().time_since_epoch().count()};
+        uint64_t m_nodesBetweenTimeChecks;
+    };
+}
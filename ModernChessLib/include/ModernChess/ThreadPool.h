@@ -0,0 +1,67 @@
+#pragma once
+
+#include "WaitCondition.h"
+
+#include <functional>
+#include <future>
+#include <memory>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <type_traits>
+#include <vector>
+
+namespace ModernChess
+{
+    /**
+     * @brief Executes submitted tasks on a fixed number of threads
+     */
+    class ThreadPool
+    {
+    public:
+        explicit ThreadPool(size_t numberOfThreads);
+
+        ThreadPool(const ThreadPool&) = delete;
+        ThreadPool(ThreadPool&&) = delete;
+        ThreadPool &operator=(const ThreadPool&) = delete;
+        ThreadPool &operator=(ThreadPool&&) = delete;
+
+        /**
+         * @brief Finishes all submitted tasks before the threads are joined
+         */
+        ~ThreadPool();
+
+        template<typename Function>
+        [[nodiscard]] std::future<std::invoke_result_t<Function>> submit(Function function)
+        {
+            using Result = std::invoke_result_t<Function>;
+
+            // std::function requires copyable functions, but std::packaged_task is only movable
+            auto task = std::make_shared<std::packaged_task<Result()>>(std::move(function));
+            std::future<Result> result = task->get_future();
+
+            {
+                const std::lock_guard lock(m_mutex);
+                m_tasks.emplace([task] { (*task)(); });
+            }
+
+            m_waitForTask.notifyOne();
+
+            return result;
+        }
+
+        [[nodiscard]] size_t numberOfThreads() const
+        {
+            return m_threads.size();
+        }
+
+    private:
+        std::mutex m_mutex;
+        WaitCondition m_waitForTask;
+        std::queue<std::function<void()>> m_tasks;
+        bool m_quit = false;
+        std::vector<std::thread> m_threads;
+
+        void executeTasks();
+    };
+}
@@ -1,11 +1,20 @@
 #pragma once
 
+#include "MemoryAllocator.h"
 #include "Move.h"
 
+#include <array>
+#include <atomic>
 #include <cinttypes>
 #include <memory>
 #include <functional>
 #include <limits>
+#include <optional>
+#include <string>
+
+#if defined(_MSC_VER)
+#include <xmmintrin.h>
+#endif
 
 namespace ModernChess {
 
@@ -17,32 +26,235 @@ namespace ModernChess {
         Beta
     };
 
+    /**
+     * @brief The table consists of clusters, which fill exactly one cache line. A position is stored in one of the
+     *        entries of its cluster. Every entry is a single 64-bit word, which is read and written atomically,
+     *        so the table can be shared between search threads without locks. The best move of an entry is stored
+     *        separately. It might belong to another position after a concurrent write and has to be verified
+     *        before it is made.
+     * @see https://www.chessprogramming.org/Transposition_Table
+     * @see https://www.chessprogramming.org/Shared_Hash_Table#Lockless
+     */
     class TranspositionTable {
     public:
+        struct Entry {
+            int32_t score{};
+            uint8_t depth{};
+            HashFlag hashFlag{};
+            // best move or refutation move. Null move, if all moves failed low.
+            Move bestMove{};
+        };
+
         TranspositionTable();
 
-        void addEntry(uint64_t hash, HashFlag flag, int32_t score, uint8_t depth);
+        /**
+         * @param bestMove If it is a null move, the best move of a previous entry of the same position is kept
+         */
+        void addEntry(uint64_t hash, HashFlag flag, int32_t score, uint8_t depth, Move bestMove = Move());
+        [[nodiscard]] std::optional<Entry> probe(uint64_t hash) const;
         [[nodiscard]] int32_t getScore(uint64_t hash, int32_t alpha, int32_t beta, uint8_t depth) const;
-        void clear();
-        void resize(size_t mbSize);
+
+        /**
+         * @brief Loads the cluster of the hash into the cache without waiting for it. Is called as soon as a move has
+         *        been made, so the memory latency overlaps with the work before the table is probed.
+         */
+        void prefetch(uint64_t hash) const
+        {
+#if defined(__GNUC__) || defined(__clang__)
+            __builtin_prefetch(&getCluster(hash));
+#elif defined(_MSC_VER)
+            _mm_prefetch(reinterpret_cast<const char*>(&getCluster(hash)), _MM_HINT_T0);
+#endif
+        }
+
+        /**
+         * @return The score, if the entry is deep enough to cut off the search, otherwise NoHashEntryFound
+         */
+        [[nodiscard]] static int32_t getScore(const Entry &entry, int32_t alpha, int32_t beta, uint8_t depth);
+
+        /**
+         * @brief The entries are zeroed with plain stores, so it must not be called, while another process
+         *        uses the shared table.
+         * @param numberOfThreads The table is split into one part per thread, which is zeroed by this thread
+         */
+        void clear(size_t numberOfThreads = 1);
+
+        /**
+         * @brief Allocates a new, empty table on huge pages, if possible
+         * @param numberOfThreads Number of threads used for zeroing the table. They only speed up the zeroing.
+         *                        The threads aren't bound to NUMA nodes and the search runs on other threads,
+         *                        so the pages are only spread across the NUMA nodes with NumaPolicy::Interleave.
+         * @return false, if the memory for mbSize can't be allocated. Then a table with the previous size or,
+         *         if that fails, too, with the default size is allocated.
+         */
+        [[nodiscard]] bool resize(size_t mbSize, size_t numberOfThreads = 1, NumaPolicy numaPolicy = NumaPolicy::FirstTouch);
+
+        [[nodiscard]] size_t sizeInMb() const
+        {
+            return m_numberClusters * sizeof(Cluster) / (1024 * 1024);
+        }
+
+        [[nodiscard]] const LargePageInfo &largePageInfo() const
+        {
+            return m_largePageInfo;
+        }
+
+        /**
+         * @brief Shares the table with other engine processes through a named shared memory segment. The entries
+         *        are written lock-free in every process. The first process creates the segment with the given size.
+         *        The other processes use the size of the existing segment, so the size of the table can differ
+         *        from mbSize. The segment is removed, when the last process detaches from it. A killed process
+         *        can't detach, so its segment has to be removed manually, e.g. from /dev/shm.
+         * @return false, if the segment can't be mapped or has been created with another table layout. Then the
+         *         table is not changed.
+         */
+        [[nodiscard]] bool attachSharedMemory(const std::string &name, size_t mbSize);
+
+        [[nodiscard]] bool isShared() const
+        {
+            return m_sharedHeader != nullptr;
+        }
+
+        /**
+         * @return true, if other processes have attached to the shared table, too
+         */
+        [[nodiscard]] bool hasOtherUsers() const
+        {
+            return m_sharedHeader != nullptr and
+                   std::atomic_ref(m_sharedHeader->numberOfUsers).load(std::memory_order_relaxed) > 1;
+        }
+
+        /**
+         * @brief Writes the table with a header to a file. It must not be called during a search.
+         * @return false, if the file can't be written
+         */
+        [[nodiscard]] bool save(const std::string &path) const;
+
+        /**
+         * @brief Maps a file written by save() as new table. The entries are only read from the file, when they are
+         *        accessed. Changes of the table are not written back to the file.
+         * @return false, if the file can't be mapped or has been written with other Zobrist keys or another table
+         *         layout. Then the table is not changed.
+         */
+        [[nodiscard]] bool load(const std::string &path);
+
+        /**
+         * @brief Ages all entries, so entries of previous searches are replaced first
+         */
+        void newSearch();
+
+        static constexpr size_t DefaultSizeInMb = 16;
+        static constexpr size_t MaxSizeInMb = 128 * 1024;
 
         // This value has been chosen, because Evaluation::Infinity is defined as std::numeric_limits<int32_t>::max() / 2
         static constexpr int32_t NoHashEntryFound = std::numeric_limits<int32_t>::max();
     private:
-        struct TTEntry {
-            TTEntry(uint64_t hash, HashFlag hashFlag, int32_t score, uint8_t depth) :
-                    hash(hash),
-                    score(score),
-                    depth(depth),
-                    hashFlag(hashFlag)
-            {}
-            uint64_t hash{};
-            int32_t score{};
-            uint8_t depth{}; //< current search depth
-            HashFlag hashFlag{};
+        /*
+         * Binary Entry Bits
+         *
+         * lower 32 bits     score
+         * next 8 bits       depth
+         * next 2 bits       hash flag
+         * next 6 bits       generation
+         * upper 16 bits     lower 16 bits of the hash key
+         *
+         * An empty entry is 0.
+         */
+        static constexpr size_t EntriesPerCluster = 5;
+        static constexpr uint8_t GenerationBits = 6;
+        static constexpr uint8_t GenerationMask = (1 << GenerationBits) - 1;
+
+        struct alignas(64) Cluster {
+            std::array<uint64_t, EntriesPerCluster> entries{};
+            // best moves of the entries [entry]
+            std::array<uint32_t, EntriesPerCluster> bestMoves{};
         };
 
-        std::unique_ptr<TTEntry[], std::function<void(TTEntry*)>> m_table;
-        size_t m_numberEntries{};
+        static_assert(sizeof(Cluster) == 64, "A cluster has to fill exactly one cache line");
+
+        /**
+         * @brief Precedes the clusters in a shared memory segment or a file. A table is only used with the same
+         *        layout and the same Zobrist keys, otherwise its entries would belong to other positions.
+         */
+        struct alignas(64) TableHeader {
+            uint64_t magic{};
+            uint32_t version{};
+            uint32_t clusterSize{};
+            uint64_t numberClusters{};
+            uint64_t zobristKeysChecksum{};
+            // Is set by the creating process, when the header is complete
+            uint32_t isInitialized{};
+            // Number of processes, which have attached to the shared memory segment
+            uint32_t numberOfUsers{};
+            // The generation is shared, so the age of an entry is the same in all processes
+            uint8_t generation{};
+        };
+
+        static_assert(sizeof(TableHeader) == sizeof(Cluster), "The clusters have to stay aligned to cache lines");
+
+        // "MCTTABLE"
+        static constexpr uint64_t HeaderMagic = 0x454c424154544d43;
+        static constexpr uint32_t LayoutVersion = 2;
+
+        std::unique_ptr<Cluster[], std::function<void(Cluster*)>> m_table;
+        size_t m_numberClusters{};
+        LargePageInfo m_largePageInfo{};
+        TableHeader *m_sharedHeader = nullptr;
+        uint8_t m_generation{};
+
+        /**
+         * @brief Maps the hash into [0, number of clusters) with a multiplication instead of a modulo
+         * @see https://lemire.me/blog/2016/06/27/a-fast-alternative-to-the-modulo-reduction/
+         */
+        [[nodiscard]] Cluster &getCluster(uint64_t hash) const
+        {
+            return m_table[multiplyHigh(hash, m_numberClusters)];
+        }
+
+        /**
+         * @return The upper 64 bits of the 128-bit product
+         */
+        [[nodiscard]] static uint64_t multiplyHigh(uint64_t a, uint64_t b)
+        {
+#if defined(__SIZEOF_INT128__)
+            // 128-bit integers are a compiler extension
+            __extension__ typedef unsigned __int128 UInt128;
+            return uint64_t((static_cast<UInt128>(a) * b) >> 64);
+#else
+            const uint64_t aLow = uint32_t(a);
+            const uint64_t aHigh = a >> 32;
+            const uint64_t bLow = uint32_t(b);
+            const uint64_t bHigh = b >> 32;
+            const uint64_t middle = aHigh * bLow + ((aLow * bLow) >> 32);
+            const uint64_t middle2 = aLow * bHigh + uint32_t(middle);
+            return aHigh * bHigh + (middle >> 32) + (middle2 >> 32);
+#endif
+        }
+
+        /**
+         * @return The number of generations, the entry is older than the current search
+         */
+        [[nodiscard]] uint8_t getAge(uint64_t entry) const;
+
+        /**
+         * @return A complete header for the current layout and Zobrist keys
+         */
+        [[nodiscard]] static TableHeader createHeader(size_t numberClusters);
+
+        /**
+         * @param mappedSizeBytes Size of the header and the clusters
+         */
+        [[nodiscard]] static bool isCompatible(const TableHeader &header, size_t mappedSizeBytes);
+
+        /**
+         * @brief Counts the process as user of the segment, unless the last user has already detached from it
+         * @return false, if the segment is about to be removed
+         */
+        [[nodiscard]] static bool addUser(TableHeader &header);
+
+        [[nodiscard]] static uint16_t getKey(uint64_t hash)
+        {
+            return uint16_t(hash);
+        }
     };
-}
\ No newline at end of file
+}
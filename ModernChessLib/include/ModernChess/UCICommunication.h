@@ -3,6 +3,9 @@
 #include "GameState.h"
 #include "Timer.h"
 #include "PeriodicTask.h"
+#include "PositionHistory.h"
+#include "StopSignal.h"
+#include "TranspositionTable.h"
 
 #include <string>
 #include <istream>
@@ -12,6 +15,7 @@
 #include <chrono>
 #include <atomic>
 #include <limits>
+#include <optional>
 
 namespace ModernChess
 {
@@ -23,14 +27,23 @@ namespace ModernChess
         static constexpr std::chrono::milliseconds InfiniteTime = std::chrono::hours (100);
         // Make sure the engine does not exceed the allowed time to search
         static constexpr std::chrono::milliseconds TimeSecurityMargin{50};
+        static constexpr size_t PerftHashTableSizeInMb = 16;
+        // The search threads check the deadline themselves every N nodes. The timer only guarantees a hard deadline.
+        static constexpr std::chrono::milliseconds DeadlineCheckPeriod{10};
 
         struct SearchRequest {
             SearchRequest() = default;
-            explicit SearchRequest(GameState gameState) : gameState(gameState) {}
+            explicit SearchRequest(GameState gameState) : gameState(gameState)
+            {
+                positionHistory.push(gameState.gameStateHash, true);
+            }
 
             GameState gameState{};
+            // positions of the game up to the game state
+            PositionHistory positionHistory{};
             uint8_t depth = 14; // default depth
-            std::chrono::time_point<std::chrono::steady_clock> timePointToStopSearch{};
+            // The search thread runs perft instead of a search, if it is set
+            std::optional<uint32_t> perftDepth{};
         };
     public:
         explicit UCICommunication(std::istream &inputStream, std::ostream &outputStream, std::ostream &errorStream);
@@ -56,11 +69,26 @@ namespace ModernChess
         std::ostream &m_errorStream;
 
         mutable std::mutex m_mutex;
+        size_t m_numberOfThreads = 1;
         bool m_stopped = true;
         bool m_quit = false;
         Timer<> m_timeSinceSearchStarted{};
         WaitCondition m_waitForSearchRequest;
         SearchRequest m_searchRequest;
+        // Is kept between the searches of a game and only cleared for a new game
+        TranspositionTable m_transpositionTable;
+        size_t m_hashSizeInMb = TranspositionTable::DefaultSizeInMb;
+        NumaPolicy m_numaPolicy = NumaPolicy::FirstTouch;
+        // Name of the shared memory segment of the table. The table is not shared, if it is empty.
+        std::string m_sharedHashName;
+        // The table is saved to and loaded from this file
+        std::string m_hashFilePath;
+        // Keeps the table on a new game, e.g. for a table, which has been loaded for an analysis
+        bool m_neverClearHash = false;
+        // The next new game doesn't clear the loaded table
+        bool m_hashHasBeenLoaded = false;
+        StopSignal m_stopSignal;
+        PeriodicTask m_deadlineTimer;
         std::thread m_searchThread;
 
         void registerToUI();
@@ -75,8 +103,28 @@ namespace ModernChess
 
         void executeGoCommand(UCIParser &parser);
 
+        /**
+         * @brief Is executed by the search thread, so the UI can stop it
+         */
+        void executePerftCommand(const GameState &gameState, uint32_t depth, size_t numberOfThreads);
+
+        void setOption(UCIParser &parser);
+
+        /**
+         * @brief Allocates the table with the current options. If the table can't be shared, a private table
+         *        is allocated.
+         */
+        void allocateHashTable();
+
+        /**
+         * @brief Sends the memory, which has actually been obtained for the transposition table, as info string
+         */
+        void reportHashTable();
+
         void createNewGame();
 
+        void setStartPosition();
+
         void searchBestMove();
 
         void setGameState(GameState gameState);
@@ -85,7 +133,9 @@ namespace ModernChess
 
         void quitGame();
 
-        [[nodiscard]] bool searchHasBeenStopped() const;
+        void checkDeadline();
+
+        [[nodiscard]] size_t getNumberOfThreads() const;
 
         [[nodiscard]] bool gameHasBeenQuit() const;
     };
@@ -61,6 +61,34 @@ namespace ModernChess
 
         [[nodiscard]] bool uiHasSentInfiniteTime();
 
+        [[nodiscard]] bool uiHasSentPerft();
+
+        [[nodiscard]] bool uiHasSentSetOption();
+
+        [[nodiscard]] bool uiHasSentOptionName();
+
+        [[nodiscard]] bool uiHasSentOptionValue();
+
+        [[nodiscard]] bool uiHasSentThreadsOption();
+
+        [[nodiscard]] bool uiHasSentHashOption();
+
+        [[nodiscard]] bool uiHasSentClearHashOption();
+
+        [[nodiscard]] bool uiHasSentNumaInterleaveOption();
+
+        [[nodiscard]] bool uiHasSentSharedHashOption();
+
+        [[nodiscard]] bool uiHasSentHashFileOption();
+
+        [[nodiscard]] bool uiHasSentSaveHashOption();
+
+        [[nodiscard]] bool uiHasSentLoadHashOption();
+
+        [[nodiscard]] bool uiHasSentNeverClearHashOption();
+
+        [[nodiscard]] bool uiHasSentTrue();
+
         [[nodiscard]] UCIMove parseMove();
 
     private:
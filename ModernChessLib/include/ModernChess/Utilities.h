@@ -2,10 +2,9 @@
 
 #include "BitBoardConstants.h"
 #include "Color.h"
-#include "Move.h"
+#include "MoveList.h"
 
 #include <ostream>
-#include <vector>
 
 namespace ModernChess {
     class Board;
@@ -15,4 +14,4 @@ std::ostream& print(std::ostream& os, ModernChess::BitBoardState bitBoardState);
 
 std::ostream& printAttackedSquares(std::ostream& os, const ModernChess::Board &board, ModernChess::Color attacker);
 
-std::ostream &operator<<(std::ostream &os, const std::vector<ModernChess::Move> &moves);
\ No newline at end of file
+std::ostream &operator<<(std::ostream &os, const ModernChess::MoveList &moves);
\ No newline at end of file
@@ -9,20 +9,21 @@ namespace ModernChess {
 
     class ZobristHasher {
     public:
-        ZobristHasher();
+        // The keys are generated at compile time
+        ZobristHasher() = delete;
 
         static uint64_t generateHash(const Board &board);
 
         // random piece keys [piece][square]
-        static std::array<std::array<uint64_t, NumberOfSquares>, NumberOfFigureTypes> pieceKeys;
+        static const std::array<std::array<uint64_t, NumberOfSquares>, NumberOfFigureTypes> pieceKeys;
 
         // random en passant keys [square]
-        static std::array<uint64_t, NumberOfSquares> enpassantKeys;
+        static const std::array<uint64_t, NumberOfSquares> enpassantKeys;
 
         // random castling keys
-        static std::array<uint64_t, 16> castleKeys;
+        static const std::array<uint64_t, 16> castleKeys;
 
         // random side key
-        static uint64_t sideKey;
+        static const uint64_t sideKey;
     };
 }
\ No newline at end of file
@@ -2,12 +2,17 @@
 #include "ModernChess/PawnAttacks.h"
 #include "ModernChess/KnightAttacks.h"
 #include "ModernChess/KingAttacks.h"
+#include "ModernChess/LineAttacks.h"
 
 namespace ModernChess {
-    const std::array<std::array<BitBoardState, 64>, 2> AttackQueries::pawnAttackTable = Attacks::generatePawnAttacks();
-    const std::array<BitBoardState, 64> AttackQueries::knightAttackTable = Attacks::generateKnightAttacks();
-    const std::array<BitBoardState, 64> AttackQueries::kingAttackTable = Attacks::generateKingAttacks();
+    // The tables are generated at compile time, so they are stored in read-only data
+    constinit const std::array<std::array<BitBoardState, 64>, 2> AttackQueries::pawnAttackTable = Attacks::generatePawnAttacks();
+    constinit const std::array<BitBoardState, 64> AttackQueries::knightAttackTable = Attacks::generateKnightAttacks();
+    constinit const std::array<BitBoardState, 64> AttackQueries::kingAttackTable = Attacks::generateKingAttacks();
+    // Only the indexing of the attack tables is selected at startup
     const BishopAttacks AttackQueries::bishopAttacks{};
     const RookAttacks AttackQueries::rookAttacks{};
-    const QueenAttacks AttackQueries::queenAttacks{bishopAttacks, rookAttacks};
+    constinit const QueenAttacks AttackQueries::queenAttacks{bishopAttacks, rookAttacks};
+    constinit const std::array<std::array<BitBoardState, 64>, 64> AttackQueries::squaresBetween = Attacks::generateSquaresBetween();
+    constinit const std::array<std::array<BitBoardState, 64>, 64> AttackQueries::lines = Attacks::generateLines();
 }
\ No newline at end of file
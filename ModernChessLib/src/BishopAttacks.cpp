@@ -4,35 +4,21 @@ using namespace ModernChess::BishopAttackHelperFunctions;
 
 namespace ModernChess {
 
-    BishopAttacks::BishopAttacks()
+    namespace
     {
-        // loop over all squares
-        for (Square square = Square::a1; square <= Square::h8; ++square)
-        {
-            // init bishop attack masks
-            attackMasks[square] = maskBishopAttacks(square);
-
-            // init current mask
-            const uint64_t attackMask = attackMasks[square];
-
-            // init relevant occupancy bit count
-            const uint32_t relevantBitsCount = BishopMetaData::relevantBits[square];
-
-            // init occupancy indices
-            const uint32_t occupancyIndices = (1 << relevantBitsCount);
+        constexpr SliderIndexingFunctions::AttackTables<BishopMetaData::tableSize> attackTables = generateBishopAttackTables();
+    }
 
-            // loop over occupancy indices
-            for (uint32_t index = 0; index < occupancyIndices; ++index)
-            {
-                // init current occupancy variation
-                const uint64_t occupancy = BitBoardOperations::setOccupancy(index, relevantBitsCount, attackMask);
+    // The tables are generated at compile time, so they are stored in read-only data
+    // and are shared by all processes of the engine.
+    constinit const std::array<BitBoardState, BishopMetaData::tableSize> BishopAttacks::magicAttacks = attackTables.magicAttacks;
 
-                // init magic index
-                const uint32_t magicIndex = (occupancy * BishopMetaData::magicNumbers[square]) >> (64 - relevantBitsCount);
+#ifdef MODERN_CHESS_USE_PEXT
+    constinit const std::array<BitBoardState, BishopMetaData::tableSize> BishopAttacks::pextAttacks = attackTables.pextAttacks;
+#endif
 
-                // init figure attacks
-                bishopAttacks[square][magicIndex] = bishopAttacksOnTheFly(occupancy, square);
-            }
-        }
-    }
+    BishopAttacks::BishopAttacks(SliderIndexing requestedIndexing) :
+            indexing{(requestedIndexing == SliderIndexing::Pext and SliderIndexingFunctions::cpuSupportsPext()) ?
+                     SliderIndexing::Pext : SliderIndexing::Magic}
+    {}
 }
\ No newline at end of file
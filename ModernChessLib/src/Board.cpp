@@ -20,17 +20,7 @@ std::ostream& operator<<(std::ostream& os, const ModernChess::Board &bitBoard)
                 os << "  " << (rank + 1);
             }
 
-            Figure figureOnSquare = Figure::None;
-
-            // loop over all figures bitboards
-            for (Figure figure = WhitePawn; figure <= BlackKing; ++figure)
-            {
-                if (BitBoardOperations::isOccupied(bitBoard.bitboards[figure], square))
-                {
-                    figureOnSquare = figure;
-                    break;
-                }
-            }
+            const Figure figureOnSquare = bitBoard.mailbox[square];
 
             // print different figureOnSquare set depending on OS
 #ifdef WIN64
@@ -1,10 +1,9 @@
 #include "ModernChess/Evaluation.h"
 
+#include "ModernChess/LegalMoveGeneration.h"
 #include "ModernChess/PseudoMoveGeneration.h"
 #include "ModernChess/MoveExecution.h"
 
-#include <algorithm>
-
 std::ostream &operator<<(std::ostream &os, const ModernChess::EvaluationResult &evalResult)
 {
     os << "info score cp " << evalResult.score << " depth " << evalResult.depth << " nodes " <<
@@ -28,9 +27,63 @@ namespace ModernChess
         // find best move within a given position
         const int32_t score = negamax(-Infinity, Infinity, depth);
 
+        completePrincipalVariation(depth);
+
         return EvaluationResult{score, m_numberOfNodes, depth, pvTable};
     }
 
+    void Evaluation::completePrincipalVariation(uint8_t depth)
+    {
+        GameState gameState = m_gameState;
+
+        for (const Move move : *pvTable)
+        {
+            MoveExecution::executeLegalMove(gameState, move);
+        }
+
+        int32_t &pvLength = pvTable->pvLength[0];
+
+        // follow the best moves of the transposition table
+        while (pvLength < depth && pvLength < MaxPly)
+        {
+            const std::optional<TranspositionTable::Entry> hashEntry = m_transpositionTable.probe(gameState.gameStateHash);
+
+            if (not hashEntry.has_value() || hashEntry->bestMove.isNullMove())
+            {
+                break;
+            }
+
+            // The best move might belong to another position with the same key
+            const Move move = hashEntry->bestMove;
+
+            if (not PseudoMoveGeneration::isPseudoLegal(gameState, move) ||
+                not LegalMoveGeneration::isLegal(gameState, LegalMoveGeneration::getCheckInfo(gameState), move))
+            {
+                break;
+            }
+
+            MoveExecution::executeLegalMove(gameState, move);
+            pvTable->pvTable[0][pvLength] = move;
+            ++pvLength;
+        }
+    }
+
+    bool Evaluation::searchHasBeenStopped()
+    {
+        if (m_stopSignal == nullptr)
+        {
+            return false;
+        }
+
+        if (m_numberOfNodes - m_numberOfNodesAtTimeCheck >= m_stopSignal->nodesBetweenTimeChecks())
+        {
+            m_numberOfNodesAtTimeCheck = m_numberOfNodes;
+            return m_stopSignal->checkDeadline();
+        }
+
+        return m_stopSignal->isStopped();
+    }
+
     bool Evaluation::kingIsInCheck() const
     {
         return kingIsInCheck(m_gameState.board.sideToMove);
@@ -48,47 +101,137 @@ namespace ModernChess
         return AttackQueries::squareIsAttackedByWhite(m_gameState.board, kingsSquare);
     }
 
-    std::vector<Move> Evaluation::generateSortedMoves()
+    bool Evaluation::makeMove(Move move, MoveType moveType, UndoRecord &undoRecord)
+    {
+        if (m_moveUndoMode == MoveUndoMode::CopyMake)
+        {
+            // preserve board state
+            m_gameStateCopies.push_back(m_gameState);
+        }
+
+        bool moveHasBeenMade = false;
+
+        if (m_moveGenerationMode == MoveGenerationMode::PseudoLegal)
+        {
+            moveHasBeenMade = MoveExecution::executeMove(m_gameState, move, moveType, undoRecord);
+        }
+        // Moves of the legal move generation don't need to be checked for exposing the king into a check
+        else if (moveType == MoveType::AllMoves or move.isCapture())
+        {
+            undoRecord = MoveExecution::executeLegalMove(m_gameState, move);
+            moveHasBeenMade = true;
+        }
+
+        if (moveHasBeenMade)
+        {
+            ++m_ply;
+            m_positionHistory.push(m_gameState.gameStateHash, PositionHistory::isIrreversible(move));
+
+            // The child node probes the transposition table after its repetition, fifty-move and check detection.
+            // The quiescence search doesn't probe the table at all.
+            if (moveType == MoveType::AllMoves)
+            {
+                m_transpositionTable.prefetch(m_gameState.gameStateHash);
+            }
+        }
+        else if (m_moveUndoMode == MoveUndoMode::CopyMake)
+        {
+            m_gameStateCopies.pop_back();
+        }
+
+        return moveHasBeenMade;
+    }
+
+    void Evaluation::undoMove(Move move, const UndoRecord &undoRecord)
     {
-        std::vector<Move> moves =  PseudoMoveGeneration::generateMoves(m_gameState);
+        --m_ply;
+        m_positionHistory.pop();
+
+        if (m_moveUndoMode == MoveUndoMode::CopyMake)
+        {
+            m_gameState = m_gameStateCopies.back();
+            m_gameStateCopies.pop_back();
+            return;
+        }
+
+        MoveExecution::undoMove(m_gameState, move, undoRecord);
+    }
 
-        if (m_followPv)
+    UndoRecord Evaluation::makeNullMove()
+    {
+        if (m_moveUndoMode == MoveUndoMode::CopyMake)
         {
-            // Has current ply a PV?
-            m_scorePv = std::any_of(moves.begin(), moves.end(), [this](const Move move){
-                return pvTable->pvTable[m_halfMoveClockRootSearch][m_gameState.halfMoveClock] == move;
-            });
-            m_followPv = m_scorePv;
+            // preserve board state
+            m_gameStateCopies.push_back(m_gameState);
         }
 
-        // Sort moves, such that captures with higher scores are evaluated first and makes an early pruning more probable
-        // Use also stable_sort, because on capture moves, we insert first the most valuable pieces!
-        std::stable_sort(moves.begin(), moves.end(), [this](const Move leftOrderedMove, const Move rightOrderedMove){
-            return scoreMove(leftOrderedMove) > scoreMove(rightOrderedMove);
-        });
+        const UndoRecord undoRecord = MoveExecution::executeNullMove(m_gameState);
+        ++m_ply;
+        // A null move is not a real move, so repetitions over a null move are not counted
+        m_positionHistory.push(m_gameState.gameStateHash, true);
+        m_transpositionTable.prefetch(m_gameState.gameStateHash);
+
+        return undoRecord;
+    }
+
+    void Evaluation::undoNullMove(const UndoRecord &undoRecord)
+    {
+        --m_ply;
+        m_positionHistory.pop();
 
-        m_scorePv = false;
+        if (m_moveUndoMode == MoveUndoMode::CopyMake)
+        {
+            m_gameState = m_gameStateCopies.back();
+            m_gameStateCopies.pop_back();
+            return;
+        }
 
-        return moves;
+        MoveExecution::undoNullMove(m_gameState, undoRecord);
     }
 
     int32_t Evaluation::negamax(int32_t alpha, int32_t beta, uint8_t depth)
     {
-        if (const int32_t score = GameState::transpositionTable.getScore(m_gameState.gameStateHash, alpha, beta, depth);
-            score != TranspositionTable::NoHashEntryFound &&
-            // In the first iteration/move/ply, there is no PV node to be returned, therefore don't return a score for the first ply.
-            m_gameState.halfMoveClock > m_halfMoveClockRootSearch
-            )
+        // Init PV length. A cutoff by the transposition table truncates the PV, which is completed after the search.
+        pvTable->pvLength[m_ply] = m_ply;
+
+        // we are too deep, hence there's an overflow of arrays relying on max ply constant
+        if (m_ply >= MaxPly)
         {
-            // Position has already been scored with at least the same depth
-            return score;
+            return evaluatePosition();
         }
 
-        // Init PV length
-        pvTable->pvLength[m_gameState.halfMoveClock] = m_gameState.halfMoveClock;
+        // The root position is always searched, so a move is found.
+        if (m_ply > 0)
+        {
+            // A repetition is scored as a draw. The side, which can avoid the repetition, will search another move.
+            if (m_positionHistory.isRepetition())
+            {
+                return DrawScore;
+            }
 
+            if (m_gameState.halfMoveClock >= FiftyMoveRuleHalfMoves)
+            {
+                return scoreFiftyMoveRule();
+            }
+        }
+
+        // The check detection runs before the probe, so it overlaps with the cache miss of the prefetched cluster
         const bool kingInCheck = kingIsInCheck();
 
+        const std::optional<TranspositionTable::Entry> hashEntry = m_transpositionTable.probe(m_gameState.gameStateHash);
+
+        if (hashEntry.has_value() &&
+            // In the first iteration/move/ply, there is no PV node to be returned, therefore don't return a score for the first ply.
+            m_ply > 0)
+        {
+            if (const int32_t score = TranspositionTable::getScore(*hashEntry, alpha, beta, depth);
+                score != TranspositionTable::NoHashEntryFound)
+            {
+                // Position has already been scored with at least the same depth
+                return score;
+            }
+        }
+
         // increase search depth if the king has been exposed into a check
         if (kingInCheck)
         {
@@ -102,12 +245,6 @@ namespace ModernChess
             return quiescenceSearch(alpha, beta);
         }
 
-        // we are too deep, hence there's an overflow of arrays relying on max half-moves constant
-        if (m_gameState.halfMoveClock >= MaxHalfMoves)
-        {
-            return evaluatePosition();
-        }
-
         // Assume alpha score does not increase
         HashFlag hashFlag = HashFlag::Alpha;
 
@@ -118,60 +255,57 @@ namespace ModernChess
         // see also https://web.archive.org/web/20071031095933/http://www.brucemo.com/compchess/programming/nullmove.htm
         if (m_allowNullMove && depth >= 3 &&
             not kingInCheck &&
-            m_gameState.halfMoveClock > m_halfMoveClockRootSearch &&
+            m_ply > 0 &&
             not isEndGame() // Null Move Pruning does not work for end games
             )
         {
             m_allowNullMove = false; // Don't allow consecutive null moves
-            // preserve board state
-            const GameState gameStateCopy = m_gameState;
-
-            // remove en passant square from hash key if available, because the new move invalidates it
-            if (m_gameState.board.enPassantTarget != Square::undefined)
-            {
-                m_gameState.gameStateHash ^= ZobristHasher::enpassantKeys[m_gameState.board.enPassantTarget];
-            }
 
-            // reset en-passant capture square, because opponent missed the chance in the last move
-            m_gameState.board.enPassantTarget = Square::undefined;
-
-            // switch the side, literally giving opponent an extra move to make
-            m_gameState.board.sideToMove = Color(!bool(m_gameState.board.sideToMove));
-            m_gameState.gameStateHash ^= ZobristHasher::sideKey;
+            // give the opponent an extra move to make
+            const UndoRecord undoRecord = makeNullMove();
 
             // search moves with reduced depth to find beta cutoffs (depth - 1 - R) where R is a depth reduction
             const int32_t score = -negamax(-beta, -beta + 1, depth - 1 - NullMovePruningDepthReduction);
 
             // restore board state
-            m_gameState = gameStateCopy;
+            undoNullMove(undoRecord);
 
             // fail-hard beta cutoff
             if (score >= beta)
             {
                 // node (move) fails high
-                GameState::transpositionTable.addEntry(m_gameState.gameStateHash, HashFlag::Beta, score, depth);
+                m_transpositionTable.addEntry(m_gameState.gameStateHash, HashFlag::Beta, score, depth);
                 return beta;
             }
         }
 
-        // create move list instance
-        const std::vector<Move> moves = generateSortedMoves();
+        // The PV move of the previous iteration is searched first, otherwise the best move of the transposition table.
+        // The best move is searched first, even if the depth of the entry has been insufficient for a cutoff.
+        const Move pvMove = m_followPv ? pvTable->pvTable[0][m_ply] : Move();
+        const Move hashMove = (pvMove.isNullMove() && hashEntry.has_value()) ? hashEntry->bestMove : pvMove;
+        MovePicker movePicker(m_gameState, m_moveGenerationMode, hashMove,
+                              m_killerMoves[m_ply], m_historyMoves, kingInCheck);
+
+        // Has current ply a PV?
+        m_followPv = m_followPv && not pvMove.isNullMove() && movePicker.hasHashMove();
+
+        // best move or refutation move, which is stored in the transposition table
+        Move bestMove{};
 
         uint32_t movesSearched = 0;
 
         // legal moves counter
         uint32_t legalMoves = 0;
 
-        // loop over moves within a move list
-        for (const Move move : moves)
+        // loop over moves yielded by the move picker
+        for (Move move = movePicker.nextMove(); not move.isNullMove(); move = movePicker.nextMove())
         {
             m_allowNullMove = true;
 
-            // preserve board state
-            const GameState gameStateCopy = m_gameState;
+            UndoRecord undoRecord;
 
             // make sure to make only legal moves
-            if (not MoveExecution::executeMove(m_gameState, move, MoveType::AllMoves))
+            if (not makeMove(move, MoveType::AllMoves, undoRecord))
             {
                 // skip to next move
                 continue;
@@ -238,7 +372,7 @@ namespace ModernChess
 
             m_allowNullMove = true;
             // take move back
-            m_gameState = gameStateCopy;
+            undoMove(move, undoRecord);
 
             ++movesSearched;
 
@@ -248,11 +382,11 @@ namespace ModernChess
                 if (not move.isCapture())
                 {
                     // store killer moves for later reuse
-                    m_killerMoves[1][m_gameState.halfMoveClock] = m_killerMoves[0][m_gameState.halfMoveClock]; // old killer move
-                    m_killerMoves[0][m_gameState.halfMoveClock] = move; // new and better killer move
+                    m_killerMoves[m_ply][1] = m_killerMoves[m_ply][0]; // old killer move
+                    m_killerMoves[m_ply][0] = move; // new and better killer move
                 }
 
-                GameState::transpositionTable.addEntry(m_gameState.gameStateHash, HashFlag::Beta, score, depth);
+                m_transpositionTable.addEntry(m_gameState.gameStateHash, HashFlag::Beta, score, depth, move);
 
                 // node (move) fails high
                 return beta;
@@ -272,11 +406,12 @@ namespace ModernChess
 
                 // PV node (move)
                 alpha = score;
+                bestMove = move;
                 hashFlag = HashFlag::Exact; // Store PV node
-                pvTable->addPrincipalVariation(move, m_gameState.halfMoveClock);
+                pvTable->addPrincipalVariation(move, m_ply);
             }
 
-            if (m_stopSearching())
+            if (searchHasBeenStopped())
             {
                 break;
             }
@@ -289,7 +424,7 @@ namespace ModernChess
             if (kingInCheck)
             {
                 // return mating score (assuming closest distance to mating position)
-                alpha = CheckMateScore + m_gameState.halfMoveClock;
+                alpha = CheckMateScore + m_ply;
             }
             else
             {
@@ -299,7 +434,7 @@ namespace ModernChess
             }
         }
 
-        GameState::transpositionTable.addEntry(m_gameState.gameStateHash, hashFlag, alpha, depth);
+        m_transpositionTable.addEntry(m_gameState.gameStateHash, hashFlag, alpha, depth, bestMove);
 
         // node (move) fails low
         return alpha;
@@ -319,8 +454,8 @@ namespace ModernChess
             return beta;
         }
 
-        // we are too deep, hence there's an overflow of arrays relying on max half-moves constant
-        if (m_gameState.halfMoveClock >= MaxHalfMoves)
+        // we are too deep, hence there's an overflow of arrays relying on max ply constant
+        if (m_ply >= MaxPly)
         {
             return evaluation;
         }
@@ -336,16 +471,18 @@ namespace ModernChess
             alpha = evaluation;
         }
 
-        const std::vector<Move> moves = generateSortedMoves();
+        // The triangular PV table doesn't contain any moves of the quiescence search
+        m_followPv = false;
 
-        // loop over moves within a move list
-        for (const Move move : moves)
+        MovePicker movePicker(m_gameState, m_moveGenerationMode, Move());
+
+        // loop over captures yielded by the move picker
+        for (Move move = movePicker.nextMove(); not move.isNullMove(); move = movePicker.nextMove())
         {
-            // preserve board state
-            const GameState gameStateCopy = m_gameState;
+            UndoRecord undoRecord;
 
             // make sure to make only legal moves
-            if (not MoveExecution::executeMove(m_gameState, move, MoveType::CapturesOnly))
+            if (not makeMove(move, MoveType::CapturesOnly, undoRecord))
             {
                 // skip to next move
                 continue;
@@ -355,12 +492,12 @@ namespace ModernChess
             const int32_t score = -quiescenceSearch(-beta, -alpha);
 
             // take move back
-            m_gameState = gameStateCopy;
+            undoMove(move, undoRecord);
 
             // fail-hard beta cutoff
             if (score >= beta)
             {
-                //GameState::transpositionTable.addEntry(m_gameState.gameStateHash, HashFlag::Beta, score, 0);
+                //m_transpositionTable.addEntry(m_gameState.gameStateHash, HashFlag::Beta, score, 0);
                 // node (move) fails high
                 return beta;
             }
@@ -373,18 +510,29 @@ namespace ModernChess
                 alpha = score;
             }
 
-            if (m_stopSearching())
+            if (searchHasBeenStopped())
             {
                 break;
             }
         }
 
-        //GameState::transpositionTable.addEntry(m_gameState.gameStateHash, hashFlag, alpha, 0);
+        //m_transpositionTable.addEntry(m_gameState.gameStateHash, hashFlag, alpha, 0);
 
         // node (move) fails low
         return alpha;
     }
 
+    int32_t Evaluation::scoreFiftyMoveRule() const
+    {
+        // A checkmate with the last move takes precedence over the fifty-move rule
+        if (kingIsInCheck() && LegalMoveGeneration::generateMoves(m_gameState).empty())
+        {
+            return CheckMateScore + m_ply;
+        }
+
+        return DrawScore;
+    }
+
     int32_t Evaluation::evaluatePosition() const
     {
         // static evaluation score
@@ -432,65 +580,6 @@ namespace ModernChess
         return (m_gameState.board.sideToMove == Color::White) ? score : -score;
     }
 
-    int32_t Evaluation::scoreMove(Move move)
-    {
-        // make sure we are dealing with PV move
-        if (m_scorePv && pvTable->pvTable[m_halfMoveClockRootSearch][m_gameState.halfMoveClock] == move)
-        {
-            // give PV move the highest score to search it first
-            return PvScore;
-        }
-
-        // score capture move
-        if (move.isCapture())
-        {
-            // init target figure with white pawn or black pawn (doesn't matter which one,
-            // because scoring with the same color yields the same valid score), in case of en-passant captures
-            Figure targetFigure = Figure::WhitePawn;
-
-            // pick up bitboard figure index ranges depending on side
-            Figure opponentsFigureStart;
-            Figure opponentsFigureEnd;
-
-            if (m_gameState.board.sideToMove == Color::White)
-            {
-                opponentsFigureStart = Figure::BlackPawn;
-                opponentsFigureEnd = Figure::BlackKing;
-            }
-            else
-            {
-                opponentsFigureStart = Figure::WhitePawn;
-                opponentsFigureEnd = Figure::BlackKing;
-            }
-
-            for (Figure figure = opponentsFigureStart; figure <= opponentsFigureEnd; ++figure)
-            {
-                if (BitBoardOperations::isOccupied(m_gameState.board.bitboards[figure], move.getTo()))
-                {
-                    targetFigure = figure;
-                    break;
-                }
-            }
-
-            // score move by MVV LVA lookup [source piece][target piece]
-            return mvvLva[move.getMovedFigure()][targetFigure] + CaptureScoreOffset;
-        }
-
-        // score 1st killer move
-        if (m_killerMoves[0][m_gameState.halfMoveClock] == move)
-        {
-            return BestKillerMoveScore;
-        }
-
-        // score 2nd killer move
-        if (m_killerMoves[1][m_gameState.halfMoveClock] == move)
-        {
-            return SecondBestKillerMoveScore;
-        }
-
-        return m_historyMoves[move.getMovedFigure()][move.getTo()];
-    }
-
     bool Evaluation::isEndGame() const
     {
         return BitBoardOperations::countBits(m_gameState.board.occupancies[Color::White]) <= NumberOfFiguresForEndGameDefinition or
@@ -1,4 +1,5 @@
 #include "ModernChess/FenParsing.h"
+#include "ModernChess/GlobalConstants.h"
 
 using namespace ModernChess;
 
@@ -111,6 +112,16 @@ namespace ModernChess::FenParsing {
 
         initOccupancyMaps(gameState);
 
+        // The move list is sized for this, so a position with more figures would overflow it
+        for (const Color color : {Color::White, Color::Black})
+        {
+            if (BitBoardOperations::countBits(gameState.board.occupancies[color]) > MaxNumberOfFiguresPerColor)
+            {
+                throw std::range_error("More than " + std::to_string(MaxNumberOfFiguresPerColor) + " figures of color " +
+                                       (color == Color::White ? "white" : "black") + " in FEN!");
+            }
+        }
+
         gameState.gameStateHash = ZobristHasher::generateHash(gameState.board);
 
         return gameState;
@@ -133,5 +144,18 @@ namespace ModernChess::FenParsing {
         // init all occupancies
         gameState.board.occupancies[Color::Both] |= gameState.board.occupancies[Color::White];
         gameState.board.occupancies[Color::Both] |= gameState.board.occupancies[Color::Black];
+
+        // init mailbox
+        for (Figure figureType = Figure::WhitePawn; figureType <= Figure::BlackKing; ++figureType)
+        {
+            for (BitBoardState bitboard = gameState.board.bitboards[figureType]; bitboard != BoardState::empty; )
+            {
+                const Square square = BitBoardOperations::bitScanForward(bitboard);
+                gameState.board.mailbox[square] = figureType;
+
+                // pop LS1B
+                bitboard = BitBoardOperations::eraseSquare(bitboard, square);
+            }
+        }
     }
 }
\ No newline at end of file
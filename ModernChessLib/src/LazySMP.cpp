@@ -0,0 +1,84 @@
+#include "ModernChess/LazySMP.h"
+#include "ModernChess/ThreadPool.h"
+
+#include <algorithm>
+#include <future>
+#include <vector>
+
+namespace ModernChess
+{
+    LazySMP::LazySMP(TranspositionTable &transpositionTable, size_t numberOfThreads) :
+            m_transpositionTable(transpositionTable),
+            m_numberOfThreads(std::clamp<size_t>(numberOfThreads, 1, MaxNumberOfThreads))
+    {}
+
+    EvaluationResult LazySMP::search(const GameState &gameState,
+                                     const PositionHistory &positionHistory,
+                                     uint8_t depth,
+                                     StopSignal &stopSignal,
+                                     const ReportIteration &reportIteration)
+    {
+        m_numberOfHelperNodes = 0;
+        m_transpositionTable.newSearch();
+
+        std::vector<std::future<void>> helpers;
+        std::unique_ptr<ThreadPool> threadPool;
+
+        if (m_numberOfThreads > 1)
+        {
+            threadPool = std::make_unique<ThreadPool>(m_numberOfThreads - 1);
+            helpers.reserve(m_numberOfThreads - 1);
+
+            for (size_t helperId = 1; helperId < m_numberOfThreads; ++helperId)
+            {
+                helpers.emplace_back(threadPool->submit([this, &gameState, &positionHistory, depth, helperId, &stopSignal] {
+                    searchAsHelper(gameState, positionHistory, depth, helperId, stopSignal);
+                }));
+            }
+        }
+
+        Evaluation evaluation(gameState, m_transpositionTable, stopSignal, positionHistory);
+        EvaluationResult evalResult;
+
+        for (uint8_t currentDepth = 1; currentDepth <= depth && (not stopSignal.checkDeadline()); ++currentDepth)
+        {
+            evalResult = evaluation.getBestMove(currentDepth);
+            evalResult.numberOfNodes += m_numberOfHelperNodes;
+            reportIteration(evalResult);
+        }
+
+        // The helper threads are only useful as long as the main thread is searching
+        stopSignal.stop();
+
+        for (std::future<void> &helper : helpers)
+        {
+            helper.get();
+        }
+
+        return evalResult;
+    }
+
+    void LazySMP::searchAsHelper(const GameState &gameState,
+                                 const PositionHistory &positionHistory,
+                                 uint8_t depth,
+                                 size_t helperId,
+                                 StopSignal &stopSignal)
+    {
+        Evaluation evaluation(gameState, m_transpositionTable, stopSignal, positionHistory);
+
+        // Every second helper thread searches one ply deeper
+        const uint8_t depthOffset = helperId % 2;
+        uint64_t numberOfNodes = 0;
+
+        for (uint8_t currentDepth = 1 + depthOffset;
+             currentDepth <= depth + depthOffset && (not stopSignal.isStopped());
+             ++currentDepth)
+        {
+            const EvaluationResult evalResult = evaluation.getBestMove(currentDepth);
+
+            // The number of nodes of the evaluation is accumulated over all iterations
+            m_numberOfHelperNodes += evalResult.numberOfNodes - numberOfNodes;
+            numberOfNodes = evalResult.numberOfNodes;
+        }
+    }
+}
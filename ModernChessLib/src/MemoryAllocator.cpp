@@ -1,5 +1,82 @@
 #include "ModernChess/MemoryAllocator.h"
 
+#include <algorithm>
+#include <cstdint>
+
+#if defined(__linux__)
+#include <sys/syscall.h>
+#include <linux/mempolicy.h>
+
+#include <fstream>
+#include <sstream>
+#endif
+
+#if defined(__unix__) || defined(__APPLE__)
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+#include <cerrno>
+#include <chrono>
+#include <thread>
+#endif
+
+namespace
+{
+#if defined(__linux__)
+    constexpr size_t HugePageSize = 2UL * 1024 * 1024;
+
+    /**
+     * @brief Reads the online NUMA nodes, e.g. "0-1,3"
+     * @return Bit mask of the online nodes. Only the first 64 nodes are supported.
+     */
+    [[nodiscard]] unsigned long getOnlineNumaNodes()
+    {
+        std::ifstream file("/sys/devices/system/node/online");
+        std::string ranges;
+
+        if (not std::getline(file, ranges))
+        {
+            return 1;
+        }
+
+        unsigned long nodeMask = 0;
+        std::stringstream rangeStream(ranges);
+
+        for (std::string range; std::getline(rangeStream, range, ',');)
+        {
+            const size_t separator = range.find('-');
+            const unsigned long first = std::stoul(range.substr(0, separator));
+            const unsigned long last = (separator == std::string::npos) ? first : std::stoul(range.substr(separator + 1));
+
+            for (unsigned long node = first; node <= last && node < 64; ++node)
+            {
+                nodeMask |= 1UL << node;
+            }
+        }
+
+        return (nodeMask != 0) ? nodeMask : 1;
+    }
+
+    /**
+     * @brief Distributes the pages round-robin across all online NUMA nodes. The pages must not have been touched.
+     *        The syscall is used directly, so libnuma is not required.
+     */
+    void interleavePages(void *mem, size_t size, ModernChess::LargePageInfo &largePageInfo)
+    {
+        const unsigned long nodeMask = getOnlineNumaNodes();
+        largePageInfo.numberOfNumaNodes = size_t(__builtin_popcountl(nodeMask));
+
+        if (largePageInfo.numberOfNumaNodes > 1)
+        {
+            largePageInfo.isInterleaved =
+                    syscall(SYS_mbind, mem, size, MPOL_INTERLEAVE, &nodeMask, sizeof(nodeMask) * 8, 0) == 0;
+        }
+    }
+#endif
+}
+
 namespace ModernChess
 {
     void* std_aligned_alloc(size_t alignment, size_t size)
@@ -17,7 +94,7 @@ namespace ModernChess
     void* MemoryAllocator::alignedAllocRawPtr(size_t allocSizeBytes)
     {
 #if defined(__linux__)
-        constexpr size_t alignment = 2UL * 1024 * 1024; // assumed 2MB page size
+        constexpr size_t alignment = HugePageSize;
 #elif defined(__APPLE__)
         constexpr size_t alignment = 16UL * 1024;
 #else
@@ -27,11 +104,228 @@ namespace ModernChess
         const size_t size = ((allocSizeBytes + alignment - 1) / alignment) * alignment;
         void *mem = std_aligned_alloc(alignment, size);
 #if defined(MADV_HUGEPAGE)
-        madvise(mem, size, MADV_HUGEPAGE);
+        if (mem)
+        {
+            madvise(mem, size, MADV_HUGEPAGE);
+        }
 #endif
         return mem;
     }
 
+    void* MemoryAllocator::largePageAllocRawPtr(size_t allocSizeBytes,
+                                                NumaPolicy numaPolicy,
+                                                LargePageInfo &largePageInfo,
+                                                size_t &mappedSizeBytes)
+    {
+        largePageInfo = LargePageInfo{};
+
+#if defined(__linux__)
+        mappedSizeBytes = ((allocSizeBytes + HugePageSize - 1) / HugePageSize) * HugePageSize;
+
+        // Reserved huge pages are only available, if the administrator has configured vm.nr_hugepages
+        void *mem = mmap(nullptr, mappedSizeBytes, PROT_READ | PROT_WRITE,
+                         MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+
+        if (mem != MAP_FAILED)
+        {
+            largePageInfo.pageBacking = PageBacking::ExplicitHugePages;
+            largePageInfo.hugePageBytes = mappedSizeBytes;
+        }
+        else
+        {
+            mem = std_aligned_alloc(HugePageSize, mappedSizeBytes);
+
+            if (not mem)
+            {
+                return nullptr;
+            }
+
+            largePageInfo.pageBacking = (madvise(mem, mappedSizeBytes, MADV_HUGEPAGE) == 0) ?
+                                        PageBacking::TransparentHugePages : PageBacking::NormalPages;
+        }
+
+        if (numaPolicy == NumaPolicy::Interleave)
+        {
+            interleavePages(mem, mappedSizeBytes, largePageInfo);
+        }
+
+        return mem;
+#else
+        (void) numaPolicy;
+        mappedSizeBytes = allocSizeBytes;
+        return alignedAllocRawPtr(allocSizeBytes);
+#endif
+    }
+
+    void MemoryAllocator::largePageFree(void* ptr, PageBacking pageBacking, size_t mappedSizeBytes)
+    {
+#if defined(__linux__)
+        if (pageBacking == PageBacking::ExplicitHugePages)
+        {
+            munmap(ptr, mappedSizeBytes);
+            return;
+        }
+#else
+        (void) pageBacking;
+        (void) mappedSizeBytes;
+#endif
+        alignedFree(ptr);
+    }
+
+    size_t MemoryAllocator::getHugePageBytes(const void *ptr, size_t sizeBytes)
+    {
+#if defined(__linux__)
+        // The kernel reports the transparent huge pages of every mapping in smaps
+        std::ifstream smaps("/proc/self/smaps");
+        const auto address = reinterpret_cast<uintptr_t>(ptr);
+        bool isInMapping = false;
+
+        for (std::string line; std::getline(smaps, line);)
+        {
+            uintptr_t begin = 0;
+            uintptr_t end = 0;
+            char separator = 0;
+
+            // A mapping starts with its address range, e.g. "7f0000000000-7f0001000000 rw-p ..."
+            if (std::istringstream header(line);
+                    header >> std::hex >> begin >> separator >> end && separator == '-')
+            {
+                isInMapping = begin <= address && address < end;
+            }
+            else if (isInMapping && line.starts_with("AnonHugePages:"))
+            {
+                size_t kiloBytes = 0;
+                std::istringstream(line.substr(line.find(':') + 1)) >> kiloBytes;
+                return std::min(kiloBytes * 1024, sizeBytes);
+            }
+        }
+#else
+        (void) ptr;
+        (void) sizeBytes;
+#endif
+        return 0;
+    }
+
+    void* MemoryAllocator::mapSharedMemory(const std::string &name,
+                                           size_t allocSizeBytes,
+                                           size_t &mappedSizeBytes,
+                                           bool &created)
+    {
+#if defined(__unix__) || defined(__APPLE__)
+        // Only one process can create the segment. All others open the existing one.
+        int fileDescriptor = shm_open(name.c_str(), O_RDWR | O_CREAT | O_EXCL, 0600);
+        created = fileDescriptor >= 0;
+
+        if (created)
+        {
+            // The new memory is filled with zeros
+            if (ftruncate(fileDescriptor, off_t(allocSizeBytes)) != 0)
+            {
+                close(fileDescriptor);
+                shm_unlink(name.c_str());
+                return nullptr;
+            }
+
+            mappedSizeBytes = allocSizeBytes;
+        }
+        else
+        {
+            if (errno != EEXIST or (fileDescriptor = shm_open(name.c_str(), O_RDWR, 0600)) < 0)
+            {
+                return nullptr;
+            }
+
+            struct stat status{};
+
+            // The creating process might not have set the size yet
+            for (size_t attempt = 0; attempt < 100 and fstat(fileDescriptor, &status) == 0 and status.st_size == 0; ++attempt)
+            {
+                std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            }
+
+            mappedSizeBytes = size_t(status.st_size);
+
+            if (mappedSizeBytes == 0)
+            {
+                close(fileDescriptor);
+                return nullptr;
+            }
+        }
+
+        void *mem = mmap(nullptr, mappedSizeBytes, PROT_READ | PROT_WRITE, MAP_SHARED, fileDescriptor, 0);
+        // The mapping keeps the segment open
+        close(fileDescriptor);
+
+        if (mem == MAP_FAILED)
+        {
+            // Nobody else can use a segment, which has never been initialized
+            if (created)
+            {
+                shm_unlink(name.c_str());
+            }
+            return nullptr;
+        }
+
+        return mem;
+#else
+        (void) name;
+        (void) allocSizeBytes;
+        mappedSizeBytes = 0;
+        created = false;
+        return nullptr;
+#endif
+    }
+
+    void MemoryAllocator::unlinkSharedMemory(const std::string &name)
+    {
+#if defined(__unix__) || defined(__APPLE__)
+        shm_unlink(name.c_str());
+#else
+        (void) name;
+#endif
+    }
+
+    void* MemoryAllocator::mapFile(const std::string &path, size_t &mappedSizeBytes)
+    {
+#if defined(__unix__) || defined(__APPLE__)
+        const int fileDescriptor = open(path.c_str(), O_RDONLY);
+
+        if (fileDescriptor < 0)
+        {
+            return nullptr;
+        }
+
+        struct stat status{};
+        mappedSizeBytes = (fstat(fileDescriptor, &status) == 0) ? size_t(status.st_size) : 0;
+
+        if (mappedSizeBytes == 0)
+        {
+            close(fileDescriptor);
+            return nullptr;
+        }
+
+        // A private mapping can be written, although the file has only been opened for reading
+        void *mem = mmap(nullptr, mappedSizeBytes, PROT_READ | PROT_WRITE, MAP_PRIVATE, fileDescriptor, 0);
+        close(fileDescriptor);
+
+        return (mem != MAP_FAILED) ? mem : nullptr;
+#else
+        (void) path;
+        mappedSizeBytes = 0;
+        return nullptr;
+#endif
+    }
+
+    void MemoryAllocator::unmapMemory(void* ptr, size_t mappedSizeBytes)
+    {
+#if defined(__unix__) || defined(__APPLE__)
+        munmap(ptr, mappedSizeBytes);
+#else
+        (void) ptr;
+        (void) mappedSizeBytes;
+#endif
+    }
+
     void MemoryAllocator::alignedFree(void* ptr)
     {
 #if defined(POSIXALIGNEDALLOC)
@@ -42,4 +336,21 @@ namespace ModernChess
         std::free(ptr);
 #endif
     }
-}
\ No newline at end of file
+}
+
+std::ostream &operator<<(std::ostream &os, ModernChess::PageBacking pageBacking)
+{
+    using ModernChess::PageBacking;
+
+    switch (pageBacking)
+    {
+        case PageBacking::ExplicitHugePages:
+            return os << "explicit huge pages";
+        case PageBacking::TransparentHugePages:
+            return os << "transparent huge pages";
+        case PageBacking::NormalPages:
+            return os << "normal pages";
+    }
+
+    return os;
+}
@@ -0,0 +1,274 @@
+#include "ModernChess/MovePicker.h"
+
+#include <algorithm>
+#include <span>
+
+namespace ModernChess
+{
+    MovePicker::MovePicker(const GameState &gameState,
+                           MoveGenerationMode moveGenerationMode,
+                           Move hashMove,
+                           const KillerMoves &killerMoves,
+                           const HistoryMoves &historyMoves,
+                           bool kingIsInCheck) :
+            m_gameState{gameState},
+            m_moveGenerationMode{moveGenerationMode},
+            // Killer moves are quiet moves, which hardly resolve a check
+            m_killerMoves{kingIsInCheck ? KillerMoves{} : killerMoves},
+            m_historyMoves{&historyMoves},
+            m_capturesOnly{false},
+            m_evasionsOnly{kingIsInCheck}
+    {
+        if (isValid(hashMove))
+        {
+            m_hashMove = hashMove;
+        }
+    }
+
+    MovePicker::MovePicker(const GameState &gameState, MoveGenerationMode moveGenerationMode, Move hashMove) :
+            m_gameState{gameState},
+            m_moveGenerationMode{moveGenerationMode},
+            m_capturesOnly{true}
+    {
+        if (hashMove.isCapture() && isValid(hashMove))
+        {
+            m_hashMove = hashMove;
+        }
+    }
+
+    Move MovePicker::nextMove()
+    {
+        switch (m_stage)
+        {
+            case Stage::HashMove:
+                m_stage = m_evasionsOnly ? Stage::GenerateEvasions : Stage::GenerateCaptures;
+
+                if (hasHashMove())
+                {
+                    return m_hashMove;
+                }
+                return nextMove();
+
+            case Stage::GenerateEvasions:
+                generateEvasions();
+                m_currentIndex = 0;
+                m_stage = Stage::Captures;
+                return nextMove();
+
+            case Stage::GenerateCaptures:
+                generateCaptures();
+                m_currentIndex = 0;
+                m_stage = Stage::Captures;
+                [[fallthrough]];
+
+            case Stage::Captures:
+                while (m_currentIndex < m_capturesEnd)
+                {
+                    const Move move = pickBestMove(m_moves, m_currentIndex, m_capturesEnd);
+
+                    // Losing captures are picked last. The quiescence search doesn't search them at all.
+                    if (m_capturesOnly && m_moves[m_currentIndex].score < 0)
+                    {
+                        break;
+                    }
+
+                    ++m_currentIndex;
+
+                    if (move != m_hashMove)
+                    {
+                        return move;
+                    }
+                }
+
+                if (m_capturesOnly)
+                {
+                    m_stage = Stage::Done;
+                    return {};
+                }
+
+                // The quiet evasions have been generated together with the capturing evasions
+                if (m_evasionsOnly)
+                {
+                    m_currentIndex = m_capturesEnd;
+                    m_stage = Stage::Quiets;
+                    return nextMove();
+                }
+
+                m_currentIndex = 0;
+                m_stage = Stage::Killers;
+                [[fallthrough]];
+
+            case Stage::Killers:
+                while (m_currentIndex < m_killerMoves.size())
+                {
+                    const Move killerMove = m_killerMoves[m_currentIndex++];
+
+                    // The same killer move might be stored twice.
+                    // Promotions have already been picked together with the captures.
+                    if (killerMove != m_hashMove &&
+                        (m_currentIndex == 1 || killerMove != m_killerMoves[0]) &&
+                        not killerMove.isCapture() &&
+                        killerMove.getPromotedPiece() == Figure::None &&
+                        isValid(killerMove))
+                    {
+                        return killerMove;
+                    }
+                }
+
+                m_stage = Stage::GenerateQuiets;
+                [[fallthrough]];
+
+            case Stage::GenerateQuiets:
+                generateQuietMoves();
+                m_currentIndex = m_capturesEnd;
+                m_stage = Stage::Quiets;
+                [[fallthrough]];
+
+            case Stage::Quiets:
+                while (m_currentIndex < m_moves.size())
+                {
+                    if (const Move move = pickBestMove(m_moves, m_currentIndex++, m_moves.size());
+                            move != m_hashMove && not isKillerMove(move))
+                    {
+                        return move;
+                    }
+                }
+
+                m_stage = Stage::Done;
+                [[fallthrough]];
+
+            case Stage::Done:
+                break;
+        }
+
+        return {};
+    }
+
+    bool MovePicker::isValid(Move move)
+    {
+        if (not PseudoMoveGeneration::isPseudoLegal(m_gameState, move))
+        {
+            return false;
+        }
+
+        // Pseudo legal moves are verified after they have been made
+        if (m_moveGenerationMode == MoveGenerationMode::PseudoLegal)
+        {
+            return true;
+        }
+
+        if (not m_checkInfo.has_value())
+        {
+            m_checkInfo = LegalMoveGeneration::getCheckInfo(m_gameState);
+        }
+
+        return LegalMoveGeneration::isLegal(m_gameState, *m_checkInfo, move);
+    }
+
+    void MovePicker::generateEvasions()
+    {
+        if (m_moveGenerationMode == MoveGenerationMode::Legal)
+        {
+            LegalMoveGeneration::generateMoves(m_gameState, m_moves);
+        }
+        else
+        {
+            PseudoMoveGeneration::generateMoves<MoveCategory::Evasions>(m_gameState, m_moves);
+        }
+
+        // Move the captures in front of the quiet moves. Rotating keeps the generation order of both.
+        for (size_t index = 0; index < m_moves.size(); ++index)
+        {
+            if (m_moves[index].move.isCapture())
+            {
+                std::rotate(m_moves.begin() + m_capturesEnd, m_moves.begin() + index, m_moves.begin() + index + 1);
+                ++m_capturesEnd;
+            }
+        }
+
+        scoreCaptures();
+        scoreQuietMoves();
+    }
+
+    void MovePicker::generateCaptures()
+    {
+        generateMoves<MoveCategory::Captures>(m_moves);
+        m_capturesEnd = m_moves.size();
+        scoreCaptures();
+
+        // Promotions without captures are scored with 0 and therefore picked after all captures
+        if (not m_capturesOnly)
+        {
+            generateMoves<MoveCategory::Promotions>(m_moves);
+            m_capturesEnd = m_moves.size();
+        }
+    }
+
+    void MovePicker::generateQuietMoves()
+    {
+        generateMoves<MoveCategory::QuietMoves>(m_moves);
+        scoreQuietMoves();
+    }
+
+    void MovePicker::scoreCaptures()
+    {
+        for (ScoredMove &scoredMove : std::span(m_moves.begin(), m_capturesEnd))
+        {
+            const Move move = scoredMove.move;
+            const Figure capturedFigure = getCapturedFigure(move);
+
+            // Capturing a figure, which is at least as valuable as the capturing one, can't lose material
+            const int32_t exchangeScore =
+                    (StaticExchangeEvaluation::figureValues[capturedFigure] >= StaticExchangeEvaluation::figureValues[move.getMovedFigure()]) ?
+                    0 : StaticExchangeEvaluation::evaluate(m_gameState.board, move);
+
+            // Good captures are scored by MVV LVA lookup [source piece][target piece],
+            // losing captures by their material loss
+            scoredMove.score = (exchangeScore >= 0) ? mvvLva[move.getMovedFigure()][capturedFigure] : exchangeScore;
+        }
+    }
+
+    void MovePicker::scoreQuietMoves()
+    {
+        for (ScoredMove &scoredMove : std::span(m_moves.begin() + m_capturesEnd, m_moves.end()))
+        {
+            scoredMove.score = (*m_historyMoves)[scoredMove.move.getMovedFigure()][scoredMove.move.getTo()];
+        }
+    }
+
+    bool MovePicker::isKillerMove(Move move) const
+    {
+        return std::find(m_killerMoves.begin(), m_killerMoves.end(), move) != m_killerMoves.end();
+    }
+
+    Move MovePicker::pickBestMove(MoveList &moves, size_t currentIndex, size_t endIndex)
+    {
+        size_t bestIndex = currentIndex;
+
+        for (size_t index = currentIndex + 1; index < endIndex; ++index)
+        {
+            if (moves[index].score > moves[bestIndex].score)
+            {
+                bestIndex = index;
+            }
+        }
+
+        // Rotate instead of swapping, so moves with the same score keep their generation order.
+        // On captures, the most valuable figures are generated first.
+        std::rotate(moves.begin() + currentIndex, moves.begin() + bestIndex, moves.begin() + bestIndex + 1);
+
+        return moves[currentIndex];
+    }
+
+    Figure MovePicker::getCapturedFigure(Move move) const
+    {
+        // Init target figure with a pawn in case of en-passant captures.
+        // The color doesn't matter, because scoring with the same color yields the same valid score.
+        if (move.isEnPassantCapture())
+        {
+            return Figure::WhitePawn;
+        }
+
+        return m_gameState.board.mailbox[move.getTo()];
+    }
+}
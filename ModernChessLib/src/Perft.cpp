@@ -0,0 +1,233 @@
+#include "ModernChess/Perft.h"
+#include "ModernChess/LegalMoveGeneration.h"
+#include "ModernChess/MemoryAllocator.h"
+#include "ModernChess/MoveExecution.h"
+#include "ModernChess/PseudoMoveGeneration.h"
+#include "ModernChess/ThreadPool.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstring>
+#include <future>
+
+namespace ModernChess
+{
+    Perft::Perft(size_t hashTableSizeInMb,
+                 size_t numberOfThreads,
+                 MoveGenerationMode moveGenerationMode,
+                 MoveUndoMode moveUndoMode) :
+            m_numberOfThreads{std::max<size_t>(numberOfThreads, 1)},
+            m_moveGenerationMode{moveGenerationMode},
+            m_moveUndoMode{moveUndoMode}
+    {
+        if (hashTableSizeInMb > 0)
+        {
+            m_numberHashEntries = hashTableSizeInMb * 1024 * 1024 / sizeof(HashEntry);
+            m_hashTable = MemoryAllocator::alignedArray<HashEntry>(m_numberHashEntries * sizeof(HashEntry));
+            std::memset(static_cast<void*>(m_hashTable.get()), 0, m_numberHashEntries * sizeof(HashEntry));
+        }
+    }
+
+    uint64_t Perft::countNodes(const GameState &gameState, uint32_t depth)
+    {
+        if (depth == 0)
+        {
+            return 1;
+        }
+
+        uint64_t numberOfNodes = 0;
+
+        for (const auto &[move, numberOfMoveNodes] : divide(gameState, depth))
+        {
+            numberOfNodes += numberOfMoveNodes;
+        }
+
+        return numberOfNodes;
+    }
+
+    Perft::DivideResult Perft::divide(const GameState &gameState, uint32_t depth, const StopSignal &stopSignal)
+    {
+        m_stopSignal = &stopSignal;
+        DivideResult divideResult = divide(gameState, depth);
+        m_stopSignal = nullptr;
+
+        return divideResult;
+    }
+
+    Perft::DivideResult Perft::divide(const GameState &gameState, uint32_t depth)
+    {
+        DivideResult divideResult;
+
+        if (depth == 0)
+        {
+            return divideResult;
+        }
+
+        std::vector<std::pair<Move, GameState>> rootMoves = generateRootMoves(gameState);
+
+        if (m_numberOfThreads == 1)
+        {
+            for (auto &[move, gameStateAfterMove] : rootMoves)
+            {
+                divideResult.emplace_back(move, countNodesRecursively(gameStateAfterMove, depth - 1));
+            }
+
+            return divideResult;
+        }
+
+        // Split the work at the root, because the subtrees of the root moves are independent of each other
+        std::vector<std::future<uint64_t>> numberOfNodesPerMove;
+
+        {
+            ThreadPool threadPool(std::min(m_numberOfThreads, rootMoves.size()));
+
+            for (auto &[move, gameStateAfterMove] : rootMoves)
+            {
+                numberOfNodesPerMove.emplace_back(threadPool.submit([this, &gameStateAfterMove, depth] {
+                    return countNodesRecursively(gameStateAfterMove, depth - 1);
+                }));
+            }
+        }
+
+        for (size_t i = 0; i < rootMoves.size(); ++i)
+        {
+            divideResult.emplace_back(rootMoves[i].first, numberOfNodesPerMove[i].get());
+        }
+
+        return divideResult;
+    }
+
+    std::vector<std::pair<Move, GameState>> Perft::generateRootMoves(const GameState &gameState) const
+    {
+        std::vector<std::pair<Move, GameState>> rootMoves;
+
+        if (m_moveGenerationMode == MoveGenerationMode::Legal)
+        {
+            for (const Move move : LegalMoveGeneration::generateMoves(gameState))
+            {
+                GameState gameStateAfterMove = gameState;
+                MoveExecution::executeLegalMove(gameStateAfterMove, move);
+                rootMoves.emplace_back(move, gameStateAfterMove);
+            }
+        }
+        else
+        {
+            for (const Move move : PseudoMoveGeneration::generateMoves(gameState))
+            {
+                if (GameState gameStateAfterMove = gameState;
+                        MoveExecution::executeMove(gameStateAfterMove, move, MoveType::AllMoves))
+                {
+                    rootMoves.emplace_back(move, gameStateAfterMove);
+                }
+            }
+        }
+
+        return rootMoves;
+    }
+
+    uint64_t Perft::countNodesRecursively(GameState &gameState, uint32_t depth)
+    {
+        if (depth == 0)
+        {
+            return 1;
+        }
+
+        uint64_t numberOfNodes = 0;
+
+        // The leaves are counted without checking the stop signal, so the check is cheap compared to the node
+        if (depth > 1 && isStopped())
+        {
+            return 0;
+        }
+
+        // The last ply is cheap enough, so it's not worth to occupy the hash table with it
+        const bool useHashTable = m_hashTable != nullptr && depth > 1 && depth <= MaxHashDepth;
+
+        if (useHashTable && probe(gameState.gameStateHash, depth, numberOfNodes))
+        {
+            return numberOfNodes;
+        }
+
+        if (m_moveGenerationMode == MoveGenerationMode::Legal)
+        {
+            const MoveList moves = LegalMoveGeneration::generateMoves(gameState);
+
+            // Bulk counting: Legal moves of the last ply don't need to be made
+            if (depth == 1)
+            {
+                return moves.size();
+            }
+
+            for (const Move move : moves)
+            {
+                if (m_moveUndoMode == MoveUndoMode::CopyMake)
+                {
+                    const GameState gameStateCopy = gameState;
+                    MoveExecution::executeLegalMove(gameState, move);
+                    numberOfNodes += countNodesRecursively(gameState, depth - 1);
+                    gameState = gameStateCopy;
+                }
+                else
+                {
+                    const UndoRecord undoRecord = MoveExecution::executeLegalMove(gameState, move);
+                    numberOfNodes += countNodesRecursively(gameState, depth - 1);
+                    MoveExecution::undoMove(gameState, move, undoRecord);
+                }
+            }
+        }
+        else
+        {
+            for (const Move move : PseudoMoveGeneration::generateMoves(gameState))
+            {
+                if (m_moveUndoMode == MoveUndoMode::CopyMake)
+                {
+                    const GameState gameStateCopy = gameState;
+
+                    if (MoveExecution::executeMove(gameState, move, MoveType::AllMoves))
+                    {
+                        numberOfNodes += countNodesRecursively(gameState, depth - 1);
+                        gameState = gameStateCopy;
+                    }
+                }
+                else if (UndoRecord undoRecord; MoveExecution::executeMove(gameState, move, MoveType::AllMoves, undoRecord))
+                {
+                    numberOfNodes += countNodesRecursively(gameState, depth - 1);
+                    MoveExecution::undoMove(gameState, move, undoRecord);
+                }
+            }
+        }
+
+        // The count of a stopped subtree is incomplete
+        if (useHashTable && not isStopped())
+        {
+            store(gameState.gameStateHash, depth, numberOfNodes);
+        }
+
+        return numberOfNodes;
+    }
+
+    bool Perft::probe(uint64_t hash, uint32_t depth, uint64_t &numberOfNodes) const
+    {
+        HashEntry &entry = m_hashTable[hash % m_numberHashEntries];
+
+        const uint64_t key = std::atomic_ref(entry.key).load(std::memory_order_relaxed);
+        const uint64_t data = std::atomic_ref(entry.data).load(std::memory_order_relaxed);
+
+        if ((key ^ data) == hash && (data & MaxHashDepth) == depth)
+        {
+            numberOfNodes = data >> 8;
+            return true;
+        }
+
+        return false;
+    }
+
+    void Perft::store(uint64_t hash, uint32_t depth, uint64_t numberOfNodes)
+    {
+        HashEntry &entry = m_hashTable[hash % m_numberHashEntries];
+        const uint64_t data = (numberOfNodes << 8) | depth;
+
+        std::atomic_ref(entry.key).store(hash ^ data, std::memory_order_relaxed);
+        std::atomic_ref(entry.data).store(data, std::memory_order_relaxed);
+    }
+}
@@ -4,35 +4,21 @@ using namespace ModernChess::RookAttackHelperFunctions;
 
 namespace ModernChess {
 
-    RookAttacks::RookAttacks()
+    namespace
     {
-        // loop over all squares
-        for (Square square = Square::a1; square <= Square::h8; ++square)
-        {
-            // init rook attack masks
-            attackMasks[square] = maskRookAttacks(square);
-
-            // init current mask
-            const uint64_t attackMask = attackMasks[square];
-
-            // init relevant occupancy bit count
-            const uint32_t relevantBitsCount = RookMetaData::relevantBits[square];
-
-            // init occupancy indices
-            const uint32_t occupancyIndices = (1 << relevantBitsCount);
+        constexpr SliderIndexingFunctions::AttackTables<RookMetaData::tableSize> attackTables = generateRookAttackTables();
+    }
 
-            // loop over occupancy indices
-            for (uint32_t index = 0; index < occupancyIndices; ++index)
-            {
-                // init current occupancy variation
-                const uint64_t occupancy = BitBoardOperations::setOccupancy(index, relevantBitsCount, attackMask);
+    // The tables are generated at compile time, so they are stored in read-only data
+    // and are shared by all processes of the engine.
+    constinit const std::array<BitBoardState, RookMetaData::tableSize> RookAttacks::magicAttacks = attackTables.magicAttacks;
 
-                // init magic index
-                const uint32_t magicIndex = (occupancy * RookMetaData::magicNumbers[square]) >> (64 - relevantBitsCount);
+#ifdef MODERN_CHESS_USE_PEXT
+    constinit const std::array<BitBoardState, RookMetaData::tableSize> RookAttacks::pextAttacks = attackTables.pextAttacks;
+#endif
 
-                // init figure attacks
-                rookAttacks[square][magicIndex] = rookAttacksOnTheFly(occupancy, square);
-            }
-        }
-    }
+    RookAttacks::RookAttacks(SliderIndexing requestedIndexing) :
+            indexing{(requestedIndexing == SliderIndexing::Pext and SliderIndexingFunctions::cpuSupportsPext()) ?
+                     SliderIndexing::Pext : SliderIndexing::Magic}
+    {}
 }
\ No newline at end of file
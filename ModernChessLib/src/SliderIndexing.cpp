@@ -0,0 +1,25 @@
+#include "ModernChess/SliderIndexing.h"
+
+namespace ModernChess::SliderIndexingFunctions {
+
+    bool cpuSupportsPext()
+    {
+#ifdef MODERN_CHESS_USE_PEXT
+        // Executes CPUID only once. The attack tables are initialized before main(),
+        // therefore the CPU features must be initialized explicitly.
+        static const bool supportsBmi2 = [] {
+            __builtin_cpu_init();
+            return __builtin_cpu_supports("bmi2") != 0;
+        }();
+
+        return supportsBmi2;
+#else
+        return false;
+#endif
+    }
+
+    SliderIndexing getDefaultIndexing()
+    {
+        return cpuSupportsPext() ? SliderIndexing::Pext : SliderIndexing::Magic;
+    }
+}
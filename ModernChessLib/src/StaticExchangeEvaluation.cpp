@@ -0,0 +1,98 @@
+#include "ModernChess/StaticExchangeEvaluation.h"
+#include "ModernChess/AttackQueries.h"
+
+#include <algorithm>
+
+namespace ModernChess
+{
+    int32_t StaticExchangeEvaluation::evaluate(const Board &board, Move move)
+    {
+        // gain of the side, which captures at the given depth of the exchange sequence
+        std::array<int32_t, MaxNumberOfExchanges> gain{};
+        size_t depth = 0;
+
+        const Square targetSquare = move.getTo();
+        BitBoardState occupancy = BitBoardOperations::eraseSquare(board.occupancies[Color::Both], move.getFrom());
+
+        if (move.isEnPassantCapture())
+        {
+            // The captured pawn is behind the target square from the view of the moving side
+            const Square capturedPawnSquare = (board.sideToMove == Color::White) ?
+                                              BitBoardOperations::getSouthSquareFromGivenSquare(targetSquare) :
+                                              BitBoardOperations::getNorthSquareFromGivenSquare(targetSquare);
+            occupancy = BitBoardOperations::eraseSquare(occupancy, capturedPawnSquare);
+            gain[0] = figureValues[Figure::WhitePawn];
+        }
+        else
+        {
+            gain[0] = figureValues[board.mailbox[targetSquare]];
+        }
+
+        // The figure, which will be captured next
+        Figure figureOnTargetSquare = move.getMovedFigure();
+
+        if (const Figure promotedPiece = move.getPromotedPiece(); promotedPiece != Figure::None)
+        {
+            gain[0] += figureValues[promotedPiece] - figureValues[Figure::WhitePawn];
+            figureOnTargetSquare = promotedPiece;
+        }
+
+        const BitBoardState diagonalSliders = board.bitboards[Figure::WhiteBishop] | board.bitboards[Figure::WhiteQueen] |
+                                              board.bitboards[Figure::BlackBishop] | board.bitboards[Figure::BlackQueen];
+        const BitBoardState straightSliders = board.bitboards[Figure::WhiteRook] | board.bitboards[Figure::WhiteQueen] |
+                                              board.bitboards[Figure::BlackRook] | board.bitboards[Figure::BlackQueen];
+
+        BitBoardState attackers = AttackQueries::attackersTo(board, targetSquare, occupancy);
+        Color color = (board.sideToMove == Color::White) ? Color::Black : Color::White;
+
+        while (depth + 1 < MaxNumberOfExchanges)
+        {
+            const Figure attacker = getLeastValuableAttacker(board, attackers, color);
+
+            if (attacker == Figure::None)
+            {
+                break;
+            }
+
+            ++depth;
+
+            // speculative gain, if the figure on the target square is captured and not recaptured
+            gain[depth] = figureValues[figureOnTargetSquare] - gain[depth - 1];
+
+            // remove the attacker from the occupancy
+            occupancy = BitBoardOperations::eraseSquare(occupancy, BitBoardOperations::bitScanForward(attackers & board.bitboards[attacker]));
+
+            // add sliding pieces, which are attacking through the removed attacker (x-rays)
+            attackers |= (AttackQueries::bishopAttacks.getAttacks(targetSquare, occupancy) & diagonalSliders) |
+                         (AttackQueries::rookAttacks.getAttacks(targetSquare, occupancy) & straightSliders);
+            attackers &= occupancy;
+
+            figureOnTargetSquare = attacker;
+            color = (color == Color::White) ? Color::Black : Color::White;
+        }
+
+        // Each side either captures or stands pat, whichever is better
+        for (; depth > 0; --depth)
+        {
+            gain[depth - 1] = -std::max(-gain[depth - 1], gain[depth]);
+        }
+
+        return gain[0];
+    }
+
+    Figure StaticExchangeEvaluation::getLeastValuableAttacker(const Board &board, BitBoardState attackers, Color color)
+    {
+        const Figure firstFigure = (color == Color::White) ? Figure::WhitePawn : Figure::BlackPawn;
+        const Figure lastFigure = (color == Color::White) ? Figure::WhiteKing : Figure::BlackKing;
+
+        for (Figure figure = firstFigure; figure <= lastFigure; ++figure)
+        {
+            if ((attackers & board.bitboards[figure]) != BoardState::empty)
+            {
+                return figure;
+            }
+        }
+
+        return Figure::None;
+    }
+}
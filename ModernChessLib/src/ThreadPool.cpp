@@ -0,0 +1,55 @@
+#include "ModernChess/ThreadPool.h"
+
+namespace ModernChess
+{
+    ThreadPool::ThreadPool(size_t numberOfThreads)
+    {
+        m_threads.reserve(numberOfThreads);
+
+        for (size_t i = 0; i < numberOfThreads; ++i)
+        {
+            m_threads.emplace_back(&ThreadPool::executeTasks, this);
+        }
+    }
+
+    ThreadPool::~ThreadPool()
+    {
+        {
+            const std::lock_guard lock(m_mutex);
+            m_quit = true;
+        }
+
+        m_waitForTask.notifyAll();
+
+        for (std::thread &thread : m_threads)
+        {
+            thread.join();
+        }
+    }
+
+    void ThreadPool::executeTasks()
+    {
+        while (true)
+        {
+            std::function<void()> task;
+
+            {
+                std::unique_lock lock(m_mutex);
+                m_waitForTask.wait(lock, [this] {
+                    return m_quit or not m_tasks.empty();
+                });
+
+                // Remaining tasks are still executed after quit
+                if (m_tasks.empty())
+                {
+                    return;
+                }
+
+                task = std::move(m_tasks.front());
+                m_tasks.pop();
+            }
+
+            task();
+        }
+    }
+}
@@ -1,61 +1,457 @@
 #include "ModernChess/TranspositionTable.h"
 #include "ModernChess/MemoryAllocator.h"
+#include "ModernChess/ThreadPool.h"
+#include "ModernChess/ZobristHasher.h"
 
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <chrono>
 #include <cstring>
+#include <fstream>
+#include <future>
+#include <new>
+#include <thread>
+#include <vector>
+
+namespace {
+    constexpr uint64_t ScoreMask = 0xFFFFFFFF;
+
+    [[nodiscard]] uint64_t encodeEntry(uint16_t key, uint8_t generation, ModernChess::HashFlag flag, int32_t score, uint8_t depth)
+    {
+        return (uint64_t(uint32_t(score))) |
+               (uint64_t(depth) << 32) |
+               (uint64_t(flag) << 40) |
+               (uint64_t(generation) << 42) |
+               (uint64_t(key) << 48);
+    }
+
+    [[nodiscard]] int32_t getEntryScore(uint64_t entry)
+    {
+        return int32_t(uint32_t(entry & ScoreMask));
+    }
+
+    [[nodiscard]] uint8_t getEntryDepth(uint64_t entry)
+    {
+        return uint8_t(entry >> 32);
+    }
+
+    [[nodiscard]] ModernChess::HashFlag getEntryHashFlag(uint64_t entry)
+    {
+        return ModernChess::HashFlag((entry >> 40) & 0x3);
+    }
+
+    [[nodiscard]] uint16_t getEntryKey(uint64_t entry)
+    {
+        return uint16_t(entry >> 48);
+    }
+
+    [[nodiscard]] uint64_t loadEntry(uint64_t &entry)
+    {
+        return std::atomic_ref(entry).load(std::memory_order_relaxed);
+    }
+
+    void storeEntry(uint64_t &entry, uint64_t value)
+    {
+        std::atomic_ref(entry).store(value, std::memory_order_relaxed);
+    }
+
+    [[nodiscard]] uint32_t loadBestMove(uint32_t &bestMove)
+    {
+        return std::atomic_ref(bestMove).load(std::memory_order_relaxed);
+    }
+
+    void storeBestMove(uint32_t &bestMove, uint32_t value)
+    {
+        std::atomic_ref(bestMove).store(value, std::memory_order_relaxed);
+    }
+
+    /**
+     * @brief Different Zobrist keys map the same position to other hashes
+     */
+    [[nodiscard]] uint64_t getZobristKeysChecksum()
+    {
+        using ModernChess::ZobristHasher;
+
+        uint64_t checksum = ZobristHasher::sideKey;
+        const auto addKey = [&checksum](uint64_t key) {
+            checksum = std::rotl(checksum, 1) ^ key;
+        };
+
+        for (const auto &squareKeys : ZobristHasher::pieceKeys)
+        {
+            std::for_each(squareKeys.begin(), squareKeys.end(), addKey);
+        }
+
+        std::for_each(ZobristHasher::enpassantKeys.begin(), ZobristHasher::enpassantKeys.end(), addKey);
+        std::for_each(ZobristHasher::castleKeys.begin(), ZobristHasher::castleKeys.end(), addKey);
+
+        return checksum;
+    }
+}
 
 namespace ModernChess {
 
     TranspositionTable::TranspositionTable()
     {
-        resize(16); // Default: 16 MB
+        // There is no smaller fallback for the default size, so a failure throws
+        (void) resize(DefaultSizeInMb);
+    }
+
+    void TranspositionTable::addEntry(uint64_t hash, HashFlag flag, int32_t score, uint8_t depth, Move bestMove)
+    {
+        Cluster &cluster = getCluster(hash);
+        const uint16_t key = getKey(hash);
+
+        size_t replacedIndex = 0;
+        int32_t lowestValue = std::numeric_limits<int32_t>::max();
+
+        for (size_t index = 0; index < EntriesPerCluster; ++index)
+        {
+            const uint64_t entryData = loadEntry(cluster.entries[index]);
+
+            // Always update the same position and fill empty entries first
+            if (entryData == 0 or getEntryKey(entryData) == key)
+            {
+                // Keep the best move of the same position, if no move has been better than alpha
+                if (bestMove.isNullMove() and entryData != 0)
+                {
+                    bestMove = Move::fromEncoding(loadBestMove(cluster.bestMoves[index]));
+                }
+
+                replacedIndex = index;
+                break;
+            }
+
+            // Replace the entry with the lowest depth, but prefer entries of older searches
+            if (const int32_t value = int32_t(getEntryDepth(entryData)) - 8 * int32_t(getAge(entryData));
+                    value < lowestValue)
+            {
+                lowestValue = value;
+                replacedIndex = index;
+            }
+        }
+
+        storeBestMove(cluster.bestMoves[replacedIndex], bestMove.getEncoding());
+        storeEntry(cluster.entries[replacedIndex], encodeEntry(key, m_generation, flag, score, depth));
     }
 
-    void TranspositionTable::addEntry(uint64_t hash, HashFlag flag, int32_t score, uint8_t depth)
+    std::optional<TranspositionTable::Entry> TranspositionTable::probe(uint64_t hash) const
     {
-        const TTEntry entry(hash, flag, score, depth);
-        const size_t index = hash % m_numberEntries;
-        m_table[index] = entry;
+        Cluster &cluster = getCluster(hash);
+        const uint16_t key = getKey(hash);
+
+        for (size_t index = 0; index < EntriesPerCluster; ++index)
+        {
+            // Load the entry only once, so it can't be changed by another thread after it has been verified
+            const uint64_t entryData = loadEntry(cluster.entries[index]);
+
+            if (entryData != 0 and getEntryKey(entryData) == key)
+            {
+                return Entry{getEntryScore(entryData),
+                             getEntryDepth(entryData),
+                             getEntryHashFlag(entryData),
+                             Move::fromEncoding(loadBestMove(cluster.bestMoves[index]))};
+            }
+        }
+
+        return std::nullopt;
     }
 
     int32_t TranspositionTable::getScore(uint64_t hash, int32_t alpha, int32_t beta, uint8_t depth) const
     {
-        const size_t index = hash % m_numberEntries;
-        const TTEntry &entry = m_table[index];
+        if (const std::optional<Entry> entry = probe(hash); entry.has_value())
+        {
+            return getScore(*entry, alpha, beta, depth);
+        }
+
+        return NoHashEntryFound;
+    }
 
-        if (entry.hash == hash)
+    int32_t TranspositionTable::getScore(const Entry &entry, int32_t alpha, int32_t beta, uint8_t depth)
+    {
+        /* The depth tells how accurate or reasonable a scoring is.
+         * I.e. the scoring of 10-ply search is more accurate/reliable than from a 3-ply search.
+         */
+        if (entry.depth > depth)
         {
-            /* The depth tells how accurate or reasonable a scoring is.
-             * I.e. the scoring of 10-ply search is more accurate/reliable than from a 3-ply search.
-             */
-            if (entry.depth > depth)
+            // PV node score
+            if (entry.hashFlag == HashFlag::Exact)
             {
-                // PV node score
-                if (entry.hashFlag == HashFlag::Exact)
-                {
-                    return entry.score;
-                }
-                if (entry.hashFlag == HashFlag::Alpha and entry.score <= alpha)
-                {
-                    return alpha;
-                }
-                if (entry.hashFlag == HashFlag::Beta and entry.score >= beta)
-                {
-                    return beta;
-                }
+                return entry.score;
+            }
+            if (entry.hashFlag == HashFlag::Alpha and entry.score <= alpha)
+            {
+                return alpha;
+            }
+            if (entry.hashFlag == HashFlag::Beta and entry.score >= beta)
+            {
+                return beta;
             }
         }
 
         return NoHashEntryFound;
     }
 
-    void TranspositionTable::resize(size_t mbSize)
+    bool TranspositionTable::resize(size_t mbSize, size_t numberOfThreads, NumaPolicy numaPolicy)
+    {
+        const size_t previousNumberClusters = m_numberClusters;
+
+        // Free the old table first, so both tables don't have to fit into memory at the same time
+        m_table.reset();
+        m_sharedHeader = nullptr;
+
+        const auto allocate = [this, numaPolicy](size_t numberClusters) {
+            m_numberClusters = numberClusters;
+            m_table = MemoryAllocator::largePageArray<Cluster>(m_numberClusters * sizeof(Cluster),
+                                                               numaPolicy,
+                                                               m_largePageInfo);
+            return m_table != nullptr;
+        };
+
+        const bool isAllocated = allocate(std::max<size_t>(mbSize * 1024 * 1024 / sizeof(Cluster), 1));
+
+        // The old table has already been freed, so its size fits into memory again
+        if (not isAllocated and
+            (previousNumberClusters == 0 or not allocate(previousNumberClusters)) and
+            not allocate(DefaultSizeInMb * 1024 * 1024 / sizeof(Cluster)))
+        {
+            throw std::bad_alloc();
+        }
+
+        clear(numberOfThreads);
+
+        // Transparent huge pages are assigned by the kernel, when the memory is touched for the first time
+        if (m_largePageInfo.pageBacking == PageBacking::TransparentHugePages)
+        {
+            m_largePageInfo.hugePageBytes = MemoryAllocator::getHugePageBytes(m_table.get(),
+                                                                              m_numberClusters * sizeof(Cluster));
+        }
+
+        return isAllocated;
+    }
+
+    bool TranspositionTable::attachSharedMemory(const std::string &name, size_t mbSize)
+    {
+        const size_t numberClusters = std::max<size_t>(mbSize * 1024 * 1024 / sizeof(Cluster), 1);
+        size_t mappedSizeBytes = 0;
+        TableHeader *header = nullptr;
+
+        // A segment, whose last user is detaching, is removed soon. Then a new segment can be created.
+        for (size_t attempt = 0; header == nullptr and attempt < 100; ++attempt)
+        {
+            bool created = false;
+            void *mem = MemoryAllocator::mapSharedMemory(name,
+                                                         sizeof(TableHeader) + numberClusters * sizeof(Cluster),
+                                                         mappedSizeBytes,
+                                                         created);
+
+            if (mem == nullptr)
+            {
+                return false;
+            }
+
+            header = static_cast<TableHeader*>(mem);
+
+            if (created)
+            {
+                // The clusters of a new segment are already zero
+                *header = createHeader(numberClusters);
+                header->numberOfUsers = 1;
+                std::atomic_ref(header->isInitialized).store(1, std::memory_order_release);
+                break;
+            }
+
+            // Wait for the creating process to complete the header
+            for (size_t wait = 0;
+                 mappedSizeBytes >= sizeof(TableHeader) and wait < 100 and std::atomic_ref(header->isInitialized).load(std::memory_order_acquire) == 0;
+                 ++wait)
+            {
+                std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            }
+
+            if (mappedSizeBytes < sizeof(TableHeader) or
+                std::atomic_ref(header->isInitialized).load(std::memory_order_acquire) == 0 or
+                not isCompatible(*header, mappedSizeBytes))
+            {
+                MemoryAllocator::unmapMemory(mem, mappedSizeBytes);
+                return false;
+            }
+
+            if (not addUser(*header))
+            {
+                MemoryAllocator::unmapMemory(mem, mappedSizeBytes);
+                header = nullptr;
+                std::this_thread::sleep_for(std::chrono::milliseconds(10));
+            }
+        }
+
+        if (header == nullptr)
+        {
+            return false;
+        }
+
+        m_table = std::unique_ptr<Cluster[], std::function<void(Cluster*)>>(
+                reinterpret_cast<Cluster*>(header + 1),
+                [header, mappedSizeBytes, name](Cluster*) {
+                    // The last user removes the segment, otherwise it would be reused with stale entries
+                    if (std::atomic_ref(header->numberOfUsers).fetch_sub(1, std::memory_order_acq_rel) == 1)
+                    {
+                        MemoryAllocator::unlinkSharedMemory(name);
+                    }
+                    MemoryAllocator::unmapMemory(header, mappedSizeBytes);
+                });
+        m_numberClusters = header->numberClusters;
+        m_largePageInfo = LargePageInfo{};
+        m_sharedHeader = header;
+        m_generation = std::atomic_ref(header->generation).load(std::memory_order_relaxed) & GenerationMask;
+
+        return true;
+    }
+
+    bool TranspositionTable::save(const std::string &path) const
+    {
+        std::ofstream file(path, std::ios::binary | std::ios::trunc);
+
+        TableHeader header = createHeader(m_numberClusters);
+        header.isInitialized = 1;
+        header.generation = m_generation;
+
+        file.write(reinterpret_cast<const char*>(&header), sizeof(header));
+        file.write(reinterpret_cast<const char*>(m_table.get()), std::streamsize(m_numberClusters * sizeof(Cluster)));
+
+        return file.good();
+    }
+
+    bool TranspositionTable::load(const std::string &path)
+    {
+        size_t mappedSizeBytes = 0;
+        void *mem = MemoryAllocator::mapFile(path, mappedSizeBytes);
+
+        if (mem == nullptr)
+        {
+            return false;
+        }
+
+        auto *header = static_cast<TableHeader*>(mem);
+
+        if (mappedSizeBytes < sizeof(TableHeader) or
+            header->isInitialized == 0 or
+            not isCompatible(*header, mappedSizeBytes))
+        {
+            MemoryAllocator::unmapMemory(mem, mappedSizeBytes);
+            return false;
+        }
+
+        m_table = std::unique_ptr<Cluster[], std::function<void(Cluster*)>>(
+                reinterpret_cast<Cluster*>(header + 1),
+                [header, mappedSizeBytes](Cluster*) {
+                    MemoryAllocator::unmapMemory(header, mappedSizeBytes);
+                });
+        m_numberClusters = header->numberClusters;
+        m_largePageInfo = LargePageInfo{};
+        // The mapping is private, so the table is not shared with other processes
+        m_sharedHeader = nullptr;
+        m_generation = header->generation & GenerationMask;
+
+        return true;
+    }
+
+    void TranspositionTable::clear(size_t numberOfThreads)
+    {
+        numberOfThreads = std::clamp<size_t>(numberOfThreads, 1, m_numberClusters);
+
+        const auto clearPart = [this, numberOfThreads](size_t part) {
+            const size_t firstCluster = part * m_numberClusters / numberOfThreads;
+            const size_t endCluster = (part + 1) * m_numberClusters / numberOfThreads;
+            std::memset(static_cast<void*>(&m_table[firstCluster]), 0, (endCluster - firstCluster) * sizeof(Cluster));
+        };
+
+        if (numberOfThreads > 1)
+        {
+            ThreadPool threadPool(numberOfThreads - 1);
+            std::vector<std::future<void>> parts;
+            parts.reserve(numberOfThreads - 1);
+
+            for (size_t part = 1; part < numberOfThreads; ++part)
+            {
+                parts.emplace_back(threadPool.submit([&clearPart, part] { clearPart(part); }));
+            }
+
+            clearPart(0);
+
+            for (std::future<void> &part : parts)
+            {
+                part.get();
+            }
+        }
+        else
+        {
+            clearPart(0);
+        }
+
+        m_generation = 0;
+
+        if (m_sharedHeader != nullptr)
+        {
+            std::atomic_ref(m_sharedHeader->generation).store(0, std::memory_order_relaxed);
+        }
+    }
+
+    void TranspositionTable::newSearch()
+    {
+        if (m_sharedHeader != nullptr)
+        {
+            const uint8_t generation = std::atomic_ref(m_sharedHeader->generation).fetch_add(1, std::memory_order_relaxed);
+            m_generation = (generation + 1) & GenerationMask;
+        }
+        else
+        {
+            m_generation = (m_generation + 1) & GenerationMask;
+        }
+    }
+
+    TranspositionTable::TableHeader TranspositionTable::createHeader(size_t numberClusters)
+    {
+        TableHeader header;
+        header.magic = HeaderMagic;
+        header.version = LayoutVersion;
+        header.clusterSize = sizeof(Cluster);
+        header.numberClusters = numberClusters;
+        header.zobristKeysChecksum = getZobristKeysChecksum();
+
+        return header;
+    }
+
+    bool TranspositionTable::addUser(TableHeader &header)
+    {
+        std::atomic_ref numberOfUsers(header.numberOfUsers);
+        uint32_t expected = numberOfUsers.load(std::memory_order_relaxed);
+
+        while (expected != 0)
+        {
+            if (numberOfUsers.compare_exchange_weak(expected, expected + 1, std::memory_order_acq_rel))
+            {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    bool TranspositionTable::isCompatible(const TableHeader &header, size_t mappedSizeBytes)
     {
-        m_numberEntries = mbSize * 1024 * 1024 / sizeof(TTEntry);
-        m_table = MemoryAllocator::alignedArray<TTEntry>(m_numberEntries * sizeof(TTEntry));
+        return header.magic == HeaderMagic and
+               header.version == LayoutVersion and
+               header.clusterSize == sizeof(Cluster) and
+               header.zobristKeysChecksum == getZobristKeysChecksum() and
+               header.numberClusters > 0 and
+               header.numberClusters <= (mappedSizeBytes - sizeof(TableHeader)) / sizeof(Cluster);
     }
 
-    void TranspositionTable::clear()
+    uint8_t TranspositionTable::getAge(uint64_t entry) const
     {
-        std::memset(m_table.get(), 0, m_numberEntries * sizeof(TTEntry));
+        const auto entryGeneration = uint8_t((entry >> 42) & GenerationMask);
+        return (m_generation - entryGeneration) & GenerationMask;
     }
-}
\ No newline at end of file
+}
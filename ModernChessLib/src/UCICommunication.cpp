@@ -1,11 +1,15 @@
 #include "ModernChess/UCICommunication.h"
 #include "ModernChess/MoveExecution.h"
-#include "ModernChess/PseudoMoveGeneration.h"
+#include "ModernChess/LegalMoveGeneration.h"
 #include "ModernChess/UCIParser.h"
 #include "ModernChess/FenParsing.h"
 #include "ModernChess/Evaluation.h"
+#include "ModernChess/LazySMP.h"
+#include "ModernChess/Perft.h"
 
+#include <algorithm>
 #include <string>
+#include <stdexcept>
 
 using ModernChess::FenParsing::FenParser;
 using namespace std::chrono_literals;
@@ -16,8 +20,11 @@ namespace ModernChess
             m_inputStream(inputStream),
             m_outputStream(outputStream),
             m_errorStream(errorStream),
+            m_deadlineTimer(DeadlineCheckPeriod, &UCICommunication::checkDeadline, this),
             m_searchThread(&UCICommunication::searchBestMove, this)
-    {}
+    {
+        m_deadlineTimer.start();
+    }
 
     UCICommunication::~UCICommunication()
     {
@@ -32,6 +39,7 @@ namespace ModernChess
     void UCICommunication::startCommunication()
     {
         registerToUI();
+        reportHashTable();
 
         std::string uiCommand;
 
@@ -58,7 +66,15 @@ namespace ModernChess
 
             if (parser.uiHasSentPosition())
             {
-                parsePosition(parser);
+                // An invalid FEN, e.g. with more figures than the move list can hold, doesn't replace the current position
+                try
+                {
+                    parsePosition(parser);
+                }
+                catch (const std::exception &exception)
+                {
+                    m_errorStream << exception.what() << std::endl;
+                }
                 continue;
             }
 
@@ -74,6 +90,10 @@ namespace ModernChess
             {
                 stopSearch();
             }
+            else if (parser.uiHasSentSetOption())
+            {
+                setOption(parser);
+            }
             else if (parser.uiRequestsUCIMode())
             {
                 registerToUI();
@@ -94,6 +114,16 @@ namespace ModernChess
     {
         m_outputStream << "id name Modern Chess\n"
                        << "id author Stefano Di Martino\n"
+                       << "option name Hash type spin default " << TranspositionTable::DefaultSizeInMb
+                       << " min 1 max " << TranspositionTable::MaxSizeInMb << "\n"
+                       << "option name Threads type spin default 1 min 1 max " << LazySMP::MaxNumberOfThreads << "\n"
+                       << "option name Clear Hash type button\n"
+                       << "option name NUMA Interleave type check default false\n"
+                       << "option name Shared Hash type string default <empty>\n"
+                       << "option name Hash File type string default <empty>\n"
+                       << "option name Save Hash to File type button\n"
+                       << "option name Load Hash from File type button\n"
+                       << "option name Never Clear Hash type check default false\n"
                        << "uciok\n" << std::flush;
     }
 
@@ -112,7 +142,7 @@ namespace ModernChess
     {
         if (parser.uiHasSentStartingPosition())
         {
-            createNewGame();
+            setStartPosition();
         }
         else if (parser.uiHasSentFENPosition())
         {
@@ -139,7 +169,9 @@ namespace ModernChess
 
                 if (not move.isNullMove())
                 {
-                    MoveExecution::executeMove(m_searchRequest.gameState, move, MoveType::AllMoves);
+                    MoveExecution::executeLegalMove(m_searchRequest.gameState, move);
+                    m_searchRequest.positionHistory.push(m_searchRequest.gameState.gameStateHash,
+                                                         PositionHistory::isIrreversible(move));
                 }
                 else
                 {
@@ -151,6 +183,22 @@ namespace ModernChess
     }
 
     void UCICommunication::createNewGame()
+    {
+        // The UI doesn't send a new game during a search, so the search thread doesn't access the table.
+        // A shared table is kept, because other processes might still search with it.
+        // A loaded table is kept for the next game, because UIs send a new game before the first search.
+        if (m_hashHasBeenLoaded)
+        {
+            m_hashHasBeenLoaded = false;
+        }
+        else if (not m_transpositionTable.isShared() and not m_neverClearHash)
+        {
+            m_transpositionTable.clear(getNumberOfThreads());
+        }
+        setStartPosition();
+    }
+
+    void UCICommunication::setStartPosition()
     {
         setGameState(FenParser(FenParsing::startPosition).parse());
     }
@@ -158,7 +206,7 @@ namespace ModernChess
     Move UCICommunication::executeMoves(UCIParser &parser) const
     {
         const UCIParser::UCIMove uciMove = parser.parseMove();
-        const std::vector<Move> possibleMovesFromCurrentSate = PseudoMoveGeneration::generateMoves(m_searchRequest.gameState);
+        const MoveList possibleMovesFromCurrentSate = LegalMoveGeneration::generateMoves(m_searchRequest.gameState);
 
         for (const Move move : possibleMovesFromCurrentSate)
         {
@@ -185,6 +233,22 @@ namespace ModernChess
 
     void UCICommunication::executeGoCommand(UCIParser &parser)
     {
+        // Perft runs on the search thread, so the UI thread can still process stop, isready and quit
+        if (parser.uiHasSentPerft())
+        {
+            const auto perftDepth = parser.parseNumber<uint32_t>();
+
+            {
+                const std::lock_guard lock(m_mutex);
+                m_searchRequest.perftDepth = perftDepth;
+                m_stopped = false;
+                m_stopSignal.reset();
+            }
+
+            m_waitForSearchRequest.notifyOne();
+            return;
+        }
+
         std::chrono::milliseconds timeToSearch = -1ms;
         std::chrono::milliseconds timeIncrement = 0ms;
         int64_t movesToGo = 1;
@@ -268,17 +332,171 @@ namespace ModernChess
 
         {
             const std::lock_guard lock(m_mutex);
+            m_searchRequest.perftDepth.reset();
             m_stopped = false;
-            m_searchRequest.timePointToStopSearch = std::chrono::steady_clock::now() + timeToSearch;
+            m_stopSignal.reset(std::chrono::steady_clock::now() + timeToSearch);
         }
 
         m_waitForSearchRequest.notifyOne();
     }
 
-    void UCICommunication::searchBestMove()
+    void UCICommunication::executePerftCommand(const GameState &gameState, uint32_t depth, size_t numberOfThreads)
     {
-        auto stopCondition = [this] { return searchHasBeenStopped(); };
+        Perft perft(PerftHashTableSizeInMb, numberOfThreads);
+        const Timer<> timer;
+        const Perft::DivideResult divideResult = perft.divide(gameState, depth, m_stopSignal);
+
+        // The node counts of a stopped perft are incomplete
+        if (m_stopSignal.isStopped())
+        {
+            m_outputStream << "info string Perft has been stopped\n" << std::flush;
+            return;
+        }
 
+        uint64_t numberOfNodes = 0;
+
+        for (const auto &[move, numberOfMoveNodes] : divideResult)
+        {
+            m_outputStream << move << ": " << numberOfMoveNodes << "\n";
+            numberOfNodes += numberOfMoveNodes;
+        }
+
+        m_outputStream << "\nNodes searched: " << numberOfNodes << "\n"
+                       << "Time: " << timer.duration().count() << " ms\n" << std::flush;
+    }
+
+    void UCICommunication::setOption(UCIParser &parser)
+    {
+        if (not parser.uiHasSentOptionName())
+        {
+            m_errorStream << "Missing name in option: " << parser.completeStringView() << std::endl;
+            return;
+        }
+
+        if (parser.uiHasSentThreadsOption() and parser.uiHasSentOptionValue())
+        {
+            const auto numberOfThreads = parser.parseNumber<size_t>();
+            const std::lock_guard lock(m_mutex);
+            m_numberOfThreads = std::clamp<size_t>(numberOfThreads, 1, LazySMP::MaxNumberOfThreads);
+        }
+        // The UI only sends options, while the engine is not searching. So the search thread doesn't access the table.
+        // "Hash File" has to be checked before "Hash"
+        else if (parser.uiHasSentHashFileOption() and parser.uiHasSentOptionValue())
+        {
+            const std::string_view path = parser.currentStringView();
+            m_hashFilePath = (path == "<empty>") ? "" : std::string(path);
+        }
+        else if (parser.uiHasSentSaveHashOption())
+        {
+            if (m_hashFilePath.empty() or not m_transpositionTable.save(m_hashFilePath))
+            {
+                m_errorStream << "Could not save the hash table to \"" << m_hashFilePath << "\"" << std::endl;
+            }
+        }
+        else if (parser.uiHasSentLoadHashOption())
+        {
+            if (m_hashFilePath.empty() or not m_transpositionTable.load(m_hashFilePath))
+            {
+                m_errorStream << "Could not load the hash table from \"" << m_hashFilePath << "\"" << std::endl;
+            }
+            else
+            {
+                m_hashHasBeenLoaded = true;
+                m_outputStream << "info string Hash " << m_transpositionTable.sizeInMb() << " MB loaded from "
+                               << m_hashFilePath << ", kept for the next new game\n" << std::flush;
+            }
+        }
+        else if (parser.uiHasSentNeverClearHashOption() and parser.uiHasSentOptionValue())
+        {
+            m_neverClearHash = parser.uiHasSentTrue();
+        }
+        else if (parser.uiHasSentHashOption() and parser.uiHasSentOptionValue())
+        {
+            m_hashSizeInMb = std::clamp<size_t>(parser.parseNumber<size_t>(), 1, TranspositionTable::MaxSizeInMb);
+            allocateHashTable();
+        }
+        else if (parser.uiHasSentNumaInterleaveOption() and parser.uiHasSentOptionValue())
+        {
+            m_numaPolicy = parser.uiHasSentTrue() ? NumaPolicy::Interleave : NumaPolicy::FirstTouch;
+            // The policy can only be applied to untouched memory, so the table is allocated again
+            allocateHashTable();
+        }
+        else if (parser.uiHasSentSharedHashOption() and parser.uiHasSentOptionValue())
+        {
+            const std::string_view name = parser.currentStringView();
+            m_sharedHashName = (name.empty() or name == "<empty>") ? "" : std::string(name);
+            allocateHashTable();
+        }
+        else if (parser.uiHasSentClearHashOption())
+        {
+            // Other processes write the entries atomically at the same time and share the generation
+            if (m_transpositionTable.hasOtherUsers())
+            {
+                m_outputStream << "info string Hash is not cleared, because other engines use it, too\n" << std::flush;
+                return;
+            }
+
+            m_hashHasBeenLoaded = false;
+            m_transpositionTable.clear(getNumberOfThreads());
+        }
+        else
+        {
+            m_errorStream << "Unknown option: " << parser.currentStringView() << std::endl;
+        }
+    }
+
+    void UCICommunication::allocateHashTable()
+    {
+        // The loaded table is replaced
+        m_hashHasBeenLoaded = false;
+
+        if (not m_sharedHashName.empty())
+        {
+            // Shared memory names have to start with a slash
+            const std::string name = m_sharedHashName.starts_with('/') ? m_sharedHashName : '/' + m_sharedHashName;
+
+            if (m_transpositionTable.attachSharedMemory(name, m_hashSizeInMb))
+            {
+                m_outputStream << "info string Hash " << m_transpositionTable.sizeInMb() << " MB shared as "
+                               << name << "\n" << std::flush;
+
+                // The segment can't be resized, while other processes use it
+                if (m_transpositionTable.sizeInMb() != m_hashSizeInMb)
+                {
+                    m_outputStream << "info string " << name << " already exists with another size, so Hash "
+                                   << m_hashSizeInMb << " MB is ignored until all engines have detached from it\n"
+                                   << std::flush;
+                }
+                return;
+            }
+
+            m_errorStream << "Could not share the hash table as " << name << std::endl;
+        }
+
+        if (not m_transpositionTable.resize(m_hashSizeInMb, getNumberOfThreads(), m_numaPolicy))
+        {
+            m_outputStream << "info string Could not allocate Hash " << m_hashSizeInMb << " MB, using "
+                           << m_transpositionTable.sizeInMb() << " MB instead\n" << std::flush;
+            // The option reports the size, which is actually used
+            m_hashSizeInMb = m_transpositionTable.sizeInMb();
+        }
+
+        reportHashTable();
+    }
+
+    void UCICommunication::reportHashTable()
+    {
+        const LargePageInfo &largePageInfo = m_transpositionTable.largePageInfo();
+
+        m_outputStream << "info string Hash " << m_transpositionTable.sizeInMb() << " MB on "
+                       << largePageInfo.pageBacking << ", " << largePageInfo.hugePageBytes / (1024 * 1024)
+                       << " MB backed by huge pages, "
+                       << (largePageInfo.isInterleaved ? "interleaved across " : "first touch on ")
+                       << largePageInfo.numberOfNumaNodes << " NUMA node(s)\n" << std::flush;
+    }
+
+    void UCICommunication::searchBestMove()
+    {
         while (not gameHasBeenQuit())
         {
             {
@@ -288,22 +506,31 @@ namespace ModernChess
                 });
             }
 
-            Evaluation evaluation(getGameState(), stopCondition);
-            EvaluationResult evalResult;
-
-            uint8_t depth;
+            SearchRequest searchRequest;
+            size_t numberOfThreads;
 
             {
                 const std::lock_guard lock(m_mutex);
-                depth = m_searchRequest.depth;
+                searchRequest = m_searchRequest;
+                numberOfThreads = m_numberOfThreads;
             }
 
-            for (uint8_t currentDepth = 1; currentDepth <= depth && (not searchHasBeenStopped()); ++currentDepth)
+            if (searchRequest.perftDepth.has_value())
             {
-                evalResult = evaluation.getBestMove(currentDepth);
-                m_outputStream << evalResult << std::flush;
+                executePerftCommand(searchRequest.gameState, *searchRequest.perftDepth, numberOfThreads);
+                stopSearch();
+                continue;
             }
 
+            LazySMP lazySMP(m_transpositionTable, numberOfThreads);
+            const EvaluationResult evalResult = lazySMP.search(searchRequest.gameState,
+                                                               searchRequest.positionHistory,
+                                                               searchRequest.depth,
+                                                               m_stopSignal,
+                                                               [this](const EvaluationResult &iterationResult) {
+                m_outputStream << iterationResult << std::flush;
+            });
+
             if (evalResult.pvTable != nullptr)
             {
                 m_outputStream << "bestmove " << evalResult.bestMove() << "\n" << std::flush;
@@ -317,6 +544,7 @@ namespace ModernChess
     {
         const std::lock_guard lock(m_mutex);
         m_stopped = true;
+        m_stopSignal.stop();
     }
 
     void UCICommunication::quitGame()
@@ -325,14 +553,26 @@ namespace ModernChess
             const std::lock_guard lock(m_mutex);
             m_stopped = true;
             m_quit = true;
+            m_stopSignal.stop();
         }
         m_waitForSearchRequest.notifyOne();
     }
 
-    bool UCICommunication::searchHasBeenStopped() const
+    void UCICommunication::checkDeadline()
+    {
+        // The lock makes sure, that the deadline of a finished search doesn't stop the next search
+        const std::lock_guard lock(m_mutex);
+
+        if (not m_stopped)
+        {
+            m_stopSignal.checkDeadline();
+        }
+    }
+
+    size_t UCICommunication::getNumberOfThreads() const
     {
         const std::lock_guard lock(m_mutex);
-        return m_stopped or (m_searchRequest.timePointToStopSearch < std::chrono::steady_clock::now());
+        return m_numberOfThreads;
     }
 
     bool UCICommunication::gameHasBeenQuit() const
@@ -95,6 +95,76 @@ namespace ModernChess
         return uiHasSentCommand("infinite");
     }
 
+    bool UCIParser::uiHasSentPerft()
+    {
+        return uiHasSentCommand("perft");
+    }
+
+    bool UCIParser::uiHasSentSetOption()
+    {
+        return uiHasSentCommand("setoption");
+    }
+
+    bool UCIParser::uiHasSentOptionName()
+    {
+        return uiHasSentCommand("name");
+    }
+
+    bool UCIParser::uiHasSentOptionValue()
+    {
+        return uiHasSentCommand("value");
+    }
+
+    bool UCIParser::uiHasSentThreadsOption()
+    {
+        return uiHasSentCommand("Threads");
+    }
+
+    bool UCIParser::uiHasSentHashOption()
+    {
+        return uiHasSentCommand("Hash");
+    }
+
+    bool UCIParser::uiHasSentClearHashOption()
+    {
+        return uiHasSentCommand("Clear Hash");
+    }
+
+    bool UCIParser::uiHasSentNumaInterleaveOption()
+    {
+        return uiHasSentCommand("NUMA Interleave");
+    }
+
+    bool UCIParser::uiHasSentSharedHashOption()
+    {
+        return uiHasSentCommand("Shared Hash");
+    }
+
+    bool UCIParser::uiHasSentHashFileOption()
+    {
+        return uiHasSentCommand("Hash File");
+    }
+
+    bool UCIParser::uiHasSentSaveHashOption()
+    {
+        return uiHasSentCommand("Save Hash to File");
+    }
+
+    bool UCIParser::uiHasSentLoadHashOption()
+    {
+        return uiHasSentCommand("Load Hash from File");
+    }
+
+    bool UCIParser::uiHasSentNeverClearHashOption()
+    {
+        return uiHasSentCommand("Never Clear Hash");
+    }
+
+    bool UCIParser::uiHasSentTrue()
+    {
+        return uiHasSentCommand("true");
+    }
+
     bool UCIParser::uiHasSentCommand(std::string_view command)
     {
         if (currentStringView().starts_with(command))
@@ -61,7 +61,7 @@ std::ostream& printAttackedSquares(std::ostream& os, const Board &board, Color a
     return os;
 }
 
-std::ostream &operator<<(std::ostream &os, const std::vector<ModernChess::Move> &moves)
+std::ostream &operator<<(std::ostream &os, const ModernChess::MoveList &moves)
 {
     using namespace ModernChess;
 
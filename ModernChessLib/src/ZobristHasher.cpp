@@ -7,41 +7,59 @@
 
 namespace ModernChess {
 
-    std::array<std::array<uint64_t, NumberOfSquares>, NumberOfFigureTypes> ZobristHasher::pieceKeys = {};
-    std::array<uint64_t, NumberOfSquares> ZobristHasher::enpassantKeys = {};
-    std::array<uint64_t, 16> ZobristHasher::castleKeys = {};
-    uint64_t ZobristHasher::sideKey = {};
-
-    ZobristHasher::ZobristHasher()
+    namespace
     {
-        PseudoRandomGenerator randomGenerator;
-        // loop over piece codes
-        for (Figure figure = Figure::WhitePawn; figure <= Figure::BlackKing; ++figure)
+        struct ZobristKeys
+        {
+            std::array<std::array<uint64_t, NumberOfSquares>, NumberOfFigureTypes> pieceKeys{};
+            std::array<uint64_t, NumberOfSquares> enpassantKeys{};
+            std::array<uint64_t, 16> castleKeys{};
+            uint64_t sideKey{};
+        };
+
+        constexpr ZobristKeys generateZobristKeys()
         {
+            ZobristKeys keys;
+            PseudoRandomGenerator randomGenerator;
+            // loop over piece codes
+            for (Figure figure = Figure::WhitePawn; figure <= Figure::BlackKing; ++figure)
+            {
+                // loop over board squares
+                for (Square square = Square::a1; square <= Square::h8; ++square)
+                {    // init random figure keys
+                    keys.pieceKeys[figure][square] = randomGenerator.getRandomU64Number();
+                }
+            }
+
             // loop over board squares
             for (Square square = Square::a1; square <= Square::h8; ++square)
-            {    // init random figure keys
-                pieceKeys[figure][square] = randomGenerator.getRandomU64Number();
+            {    // init random en passant keys
+                keys.enpassantKeys[square] = randomGenerator.getRandomU64Number();
             }
-        }
 
-        // loop over board squares
-        for (Square square = Square::a1; square <= Square::h8; ++square)
-        {    // init random en passant keys
-            enpassantKeys[square] = randomGenerator.getRandomU64Number();
-        }
+            // loop over castling keys (see CastlingRights.h)
+            for (uint8_t index = 0; index < 16; ++index)
+            {
+                // init castling keys
+                keys.castleKeys[index] = randomGenerator.getRandomU64Number();
+            }
 
-        // loop over castling keys (see CastlingRights.h)
-        for (uint8_t index = 0; index < 16; ++index)
-        {
-            // init castling keys
-            castleKeys[index] = randomGenerator.getRandomU64Number();
+            // init random side key
+            keys.sideKey = randomGenerator.getRandomU64Number();
+
+            return keys;
         }
 
-        // init random side key
-        sideKey = randomGenerator.getRandomU64Number();
+        constexpr ZobristKeys zobristKeys = generateZobristKeys();
     }
 
+    // PseudoRandomGenerator is deterministic, so the keys are generated at compile time
+    // and are stored in read-only data.
+    constinit const std::array<std::array<uint64_t, NumberOfSquares>, NumberOfFigureTypes> ZobristHasher::pieceKeys = zobristKeys.pieceKeys;
+    constinit const std::array<uint64_t, NumberOfSquares> ZobristHasher::enpassantKeys = zobristKeys.enpassantKeys;
+    constinit const std::array<uint64_t, 16> ZobristHasher::castleKeys = zobristKeys.castleKeys;
+    constinit const uint64_t ZobristHasher::sideKey = zobristKeys.sideKey;
+
     uint64_t ZobristHasher::generateHash(const Board &board)
     {
         uint64_t finalKey = 0;
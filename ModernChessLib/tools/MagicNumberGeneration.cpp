@@ -0,0 +1,143 @@
+#include "ModernChess/BishopAttacks.h"
+#include "ModernChess/PseudoRandomGenerator.h"
+#include "ModernChess/RookAttacks.h"
+
+#include <array>
+#include <cstdlib>
+#include <iomanip>
+#include <iostream>
+#include <optional>
+#include <vector>
+
+using namespace ModernChess;
+
+namespace {
+    constexpr uint32_t MaxNumberOfCandidates = 100'000'000;
+
+    /**
+     * @brief Magic numbers with few set bits are more likely to map the occupancies without collisions
+     */
+    uint64_t generateMagicNumberCandidate(PseudoRandomGenerator &randomGenerator)
+    {
+        return randomGenerator.getRandomU64Number() &
+               randomGenerator.getRandomU64Number() &
+               randomGenerator.getRandomU64Number();
+    }
+
+    /**
+     * @brief Tries random candidates until one of them maps every relevant occupancy of the square
+     *        to an index, which is either unused or stores the same attacks (constructive collision).
+     * @see https://www.chessprogramming.org/Looking_for_Magics
+     */
+    template<typename AttacksOnTheFly>
+    std::optional<uint64_t> findMagicNumber(Square square,
+                                            BitBoardState attackMask,
+                                            uint32_t relevantBits,
+                                            AttacksOnTheFly attacksOnTheFly,
+                                            PseudoRandomGenerator &randomGenerator)
+    {
+        const uint32_t numberOfOccupancies = 1U << BitBoardOperations::countBits(attackMask);
+
+        std::vector<BitBoardState> occupancies(numberOfOccupancies);
+        std::vector<BitBoardState> attacks(numberOfOccupancies);
+
+        for (uint32_t index = 0; index < numberOfOccupancies; ++index)
+        {
+            occupancies[index] = BitBoardOperations::setOccupancy(index, BitBoardOperations::countBits(attackMask), attackMask);
+            attacks[index] = attacksOnTheFly(occupancies[index], square);
+        }
+
+        std::vector<BitBoardState> usedAttacks(size_t(1) << relevantBits);
+
+        for (uint32_t candidateCount = 0; candidateCount < MaxNumberOfCandidates; ++candidateCount)
+        {
+            const uint64_t magicNumber = generateMagicNumberCandidate(randomGenerator);
+
+            // skip inappropriate magic numbers
+            if (BitBoardOperations::countBits((attackMask * magicNumber) & 0xFF00000000000000ULL) < 6)
+            {
+                continue;
+            }
+
+            std::fill(usedAttacks.begin(), usedAttacks.end(), BoardState::empty);
+
+            bool collision = false;
+
+            for (uint32_t index = 0; not collision && index < numberOfOccupancies; ++index)
+            {
+                const uint64_t magicIndex = (occupancies[index] * magicNumber) >> (64 - relevantBits);
+
+                if (usedAttacks[magicIndex] == BoardState::empty)
+                {
+                    usedAttacks[magicIndex] = attacks[index];
+                }
+                else if (usedAttacks[magicIndex] != attacks[index])
+                {
+                    collision = true;
+                }
+            }
+
+            if (not collision)
+            {
+                return magicNumber;
+            }
+        }
+
+        return std::nullopt;
+    }
+
+    template<typename MaskAttacks, typename AttacksOnTheFly>
+    bool printMagicNumbers(const char *figureName,
+                           const std::array<uint32_t, 64> &relevantBits,
+                           MaskAttacks maskAttacks,
+                           AttacksOnTheFly attacksOnTheFly,
+                           PseudoRandomGenerator &randomGenerator)
+    {
+        std::cout << "// " << figureName << " magic numbers" << std::endl;
+        std::cout << "constexpr std::array<uint64_t, 64> magicNumbers{" << std::endl;
+
+        for (Square square = Square::a1; square <= Square::h8; ++square)
+        {
+            const std::optional<uint64_t> magicNumber = findMagicNumber(square,
+                                                                        maskAttacks(square),
+                                                                        relevantBits[square],
+                                                                        attacksOnTheFly,
+                                                                        randomGenerator);
+
+            if (not magicNumber.has_value())
+            {
+                std::cerr << "No magic number found for square " << square << std::endl;
+                return false;
+            }
+
+            std::cout << "        0x" << std::hex << *magicNumber << std::dec << "ULL"
+                      << (square < Square::h8 ? "," : "") << std::endl;
+        }
+
+        std::cout << "};" << std::endl << std::endl;
+
+        return true;
+    }
+}
+
+/**
+ * @brief Generates the magic numbers of RookAttacks.h and BishopAttacks.h for their relevant bits
+ */
+int main()
+{
+    PseudoRandomGenerator randomGenerator;
+
+    const bool foundRookMagicNumbers = printMagicNumbers("rook",
+                                                         RookAttackHelperFunctions::RookMetaData::relevantBits,
+                                                         RookAttackHelperFunctions::maskRookAttacks,
+                                                         RookAttackHelperFunctions::rookAttacksOnTheFly,
+                                                         randomGenerator);
+
+    const bool foundBishopMagicNumbers = printMagicNumbers("bishop",
+                                                           BishopAttackHelperFunctions::BishopMetaData::relevantBits,
+                                                           BishopAttackHelperFunctions::maskBishopAttacks,
+                                                           BishopAttackHelperFunctions::bishopAttacksOnTheFly,
+                                                           randomGenerator);
+
+    return (foundRookMagicNumbers and foundBishopMagicNumbers) ? EXIT_SUCCESS : EXIT_FAILURE;
+}